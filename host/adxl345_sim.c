@@ -0,0 +1,189 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "altera_up_avalon_accelerometer_spi.h"
+#include "DE10_Lite_Arduino_Driver.h"
+#include "adxl345.h"
+#include "sim.h"
+
+// Ticks the application keeps running after the last sample was read,
+// so the slower tasks process and draw it
+#define SIM_DRAIN_TICKS 200
+
+static alt_16 *samples;                 // x, y, z per sample
+static size_t sample_count;
+static size_t capacity;
+
+/* ================================================================
+ *                          REPLAY FILE
+ *  One sample per line, either "x,y,z" or the "seq,timestamp,x,y,z"
+ *  CSV written by tools/stream_receiver.py. Other lines are skipped.
+ * ================================================================ */
+bool sim_replay_load(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[256];
+
+    if (!f)
+        return false;
+
+    while (fgets(line, sizeof(line), f))
+    {
+        long v[5];
+        int n = sscanf(line, "%ld,%ld,%ld,%ld,%ld", &v[0], &v[1], &v[2], &v[3], &v[4]);
+        long *xyz;
+
+        if (n == 3)
+            xyz = &v[0];
+        else if (n == 5)
+            xyz = &v[2];
+        else
+            continue;
+
+        if (sample_count == capacity)
+        {
+            capacity = capacity ? capacity * 2 : 4096;
+            samples = realloc(samples, capacity * 3 * sizeof(*samples));
+        }
+
+        for (int a = 0; a < 3; a++)
+            samples[sample_count * 3 + a] = (alt_16)xyz[a];
+        sample_count++;
+    }
+
+    fclose(f);
+    return true;
+}
+
+size_t sim_replay_count(void)
+{
+    return sample_count;
+}
+
+const alt_16 *sim_replay_sample(size_t index)
+{
+    return &samples[index * 3];
+}
+
+/* ================================================================
+ *                      SIMULATED ADXL345
+ *  The FIFO holds every sample due at the output data rate that was
+ *  not read yet, up to ADXL345_FIFO_DEPTH; in stream mode older
+ *  entries are overwritten. Reading DATAZ1 pops the head entry.
+ * ================================================================ */
+static alt_u32 odr_hz = 100;
+static alt_u64 start_us;                // When BW_RATE was written
+static size_t popped;
+static alt_u8 data[6];                  // DATAX0..DATAZ1 of the head entry
+
+static size_t produced(void)
+{
+    size_t due = (size_t)((sim_time_us() - start_us) * odr_hz / 1000000);
+    return due < sample_count ? due : sample_count;
+}
+
+static size_t entries(void)
+{
+    size_t available = produced();
+
+    if (available - popped > ADXL345_FIFO_DEPTH)
+        popped = available - ADXL345_FIFO_DEPTH;
+
+    return available - popped;
+}
+
+static void latch(void)
+{
+    const alt_16 *s = sim_replay_sample(popped);
+
+    for (int a = 0; a < 3; a++)
+    {
+        data[a * 2] = (alt_u8)s[a];
+        data[a * 2 + 1] = (alt_u8)((alt_u16)s[a] >> 8);
+    }
+}
+
+static void pop(void)
+{
+    if (++popped == sample_count)
+        sim_set_end(sim_ticks() + SIM_DRAIN_TICKS);
+}
+
+bool sim_replay_done(void)
+{
+    return popped == sample_count;
+}
+
+alt_up_accelerometer_spi_dev *alt_up_accelerometer_spi_open_dev(const char *name)
+{
+    static int dev;
+
+    (void)name;
+    return (alt_up_accelerometer_spi_dev *)&dev;
+}
+
+int alt_up_accelerometer_spi_read(alt_up_accelerometer_spi_dev *dev, alt_u8 addr, alt_u8 *value)
+{
+    (void)dev;
+
+    if (addr == ADXL345_FIFO_STATUS)
+    {
+        *value = (alt_u8)entries();
+    }
+    else if (addr >= ADXL345_DATAX0 && addr < ADXL345_DATAX0 + 6)
+    {
+        if (addr == ADXL345_DATAX0 && entries() > 0)
+            latch();
+
+        *value = data[addr - ADXL345_DATAX0];
+
+        if (addr == ADXL345_DATAX0 + 5 && entries() > 0)
+            pop();
+    }
+    else
+    {
+        *value = 0;
+    }
+
+    return 0;
+}
+
+int alt_up_accelerometer_spi_write(alt_up_accelerometer_spi_dev *dev, alt_u8 addr, alt_u8 value)
+{
+    (void)dev;
+
+    // BW_RATE codes 0x0A..0x0F are 100..3200 Hz
+    if (addr == ADXL345_BW_RATE && value >= 0x0A && value <= 0x0F)
+    {
+        odr_hz = 3200 >> (0x0F - value);
+        start_us = sim_time_us();
+        popped = 0;
+    }
+
+    return 0;
+}
+
+/* ================================================================
+ *                      BOARD DRIVER CALLS
+ * ================================================================ */
+bool accelerometer_open_dev(void)
+{
+    return true;
+}
+
+bool accelerometer_init(void)
+{
+    return true;
+}
+
+void accelerometer_receive(alt_16 *x, alt_16 *y, alt_16 *z)
+{
+    if (entries() > 0)
+    {
+        latch();
+        pop();
+    }
+
+    *x = (alt_16)(data[0] | data[1] << 8);
+    *y = (alt_16)(data[2] | data[3] << 8);
+    *z = (alt_16)(data[4] | data[5] << 8);
+}
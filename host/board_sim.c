@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include <string.h>
+#include "DE10_Lite_VGA_Driver.h"
+#include "io.h"
+#include "system.h"
+#include "app_config.h"
+#include "font8x8.h"
+#include "sim.h"
+
+/* ================================================================
+ *                          PUSH BUTTONS
+ *  Active low. KEY0 reads as pressed once, to leave the welcome
+ *  screen, and both keys are released from then on.
+ * ================================================================ */
+alt_u32 sim_io_read(alt_u32 base, alt_u32 reg)
+{
+    static bool welcome_passed;
+
+    if (base == PIO_BUTTONS_IN_BASE && reg == 0)
+    {
+        if (!welcome_passed)
+        {
+            welcome_passed = true;
+            return 0x2;
+        }
+        return 0x3;
+    }
+
+    return 0;
+}
+
+void sim_io_write(alt_u32 base, alt_u32 reg, alt_u32 data)
+{
+    (void)base; (void)reg; (void)data;
+}
+
+/* ================================================================
+ *                          VGA SCREEN
+ * ================================================================ */
+static alt_u16 screen[CANVAS_HEIGHT][CANVAS_WIDTH];
+
+void write_pixel(int x, int y, short color)
+{
+    if (x >= 0 && x < CANVAS_WIDTH && y >= 0 && y < CANVAS_HEIGHT)
+        screen[y][x] = (alt_u16)color;
+}
+
+// Framebuffer stores of a build with VGA_FB_BASE: pixel x of row y at
+// byte y * VGA_FB_STRIDE + 2 x, the lower address the left pixel
+void sim_io_write_direct(alt_u32 address, alt_u32 data, unsigned bytes)
+{
+#ifdef VGA_FB_BASE
+    alt_u32 offset = address - VGA_FB_BASE;
+
+    for (unsigned i = 0; i < bytes; i += 2, data >>= 16)
+        write_pixel((int)((offset + i) % VGA_FB_STRIDE / 2),
+                    (int)((offset + i) / VGA_FB_STRIDE), (short)data);
+#else
+    (void)address; (void)data; (void)bytes;
+#endif
+}
+
+void clear_screen(int color)
+{
+    for (int y = 0; y < CANVAS_HEIGHT; y++)
+        for (int x = 0; x < CANVAS_WIDTH; x++)
+            screen[y][x] = (alt_u16)color;
+}
+
+void tty_print(int x, int y, const char *text, int fg, int bg)
+{
+    for (; *text; text++, x += 8)
+    {
+        char c = *text;
+        const alt_u8 *rows;
+
+        if (c < FONT8X8_FIRST || c > FONT8X8_LAST)
+            c = '?';
+        rows = font8x8[c - FONT8X8_FIRST];
+
+        for (int r = 0; r < 8; r++)
+            for (int col = 0; col < 8; col++)
+                write_pixel(x + col, y + r, (rows[r] >> col) & 1 ? fg : bg);
+    }
+}
+
+void int_print(int x, int y, int value, int digits, int fg, int bg)
+{
+    char text[16];
+
+    snprintf(text, sizeof(text), "%*d", digits, value);
+    tty_print(x, y, text, fg, bg);
+}
+
+void draw_hline(int x, int y, int length, int color)
+{
+    for (int i = 0; i < length; i++)
+        write_pixel(x + i, y, color);
+}
+
+void draw_vline(int x, int y, int length, int color)
+{
+    for (int i = 0; i < length; i++)
+        write_pixel(x, y + i, color);
+}
+
+void draw_filled_circle(int x, int y, int radius, int color)
+{
+    for (int dy = -radius; dy <= radius; dy++)
+        for (int dx = -radius; dx <= radius; dx++)
+            if (dx * dx + dy * dy <= radius * radius)
+                write_pixel(x + dx, y + dy, color);
+}
+
+bool sim_screen_save(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+
+    if (!f)
+        return false;
+
+    fprintf(f, "P6\n%d %d\n255\n", CANVAS_WIDTH, CANVAS_HEIGHT);
+
+    for (int y = 0; y < CANVAS_HEIGHT; y++)
+    {
+        for (int x = 0; x < CANVAS_WIDTH; x++)
+        {
+            alt_u16 c = screen[y][x];
+            alt_u8 rgb[3] = {
+                (alt_u8)((c >> 11) << 3),
+                (alt_u8)(((c >> 5) & 0x3F) << 2),
+                (alt_u8)((c & 0x1F) << 3),
+            };
+            fwrite(rgb, 1, sizeof(rgb), f);
+        }
+    }
+
+    return fclose(f) == 0;
+}
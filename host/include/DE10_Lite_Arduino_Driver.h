@@ -0,0 +1,12 @@
+#ifndef DE10_LITE_ARDUINO_DRIVER_H_
+#define DE10_LITE_ARDUINO_DRIVER_H_
+
+/* Host build: the accelerometer calls of the board driver (adxl345_sim.c) */
+#include <stdbool.h>
+#include <alt_types.h>
+
+bool accelerometer_open_dev(void);
+bool accelerometer_init(void);
+void accelerometer_receive(alt_16 *x, alt_16 *y, alt_16 *z);
+
+#endif /* DE10_LITE_ARDUINO_DRIVER_H_ */
@@ -0,0 +1,28 @@
+#ifndef DE10_LITE_VGA_DRIVER_H_
+#define DE10_LITE_VGA_DRIVER_H_
+
+/* Host build: the VGA driver draws into a simulated screen (vga_sim.c) */
+#include <alt_types.h>
+
+#define CANVAS_WIDTH  320
+#define CANVAS_HEIGHT 240
+
+// RGB565
+#define Col_Black    0x0000
+#define Col_White    0xFFFF
+#define Col_Red      0xF800
+#define Col_Green    0x07E0
+#define Col_Blue     0x001F
+#define Col_Cyan     0x07FF
+#define Col_Magenta  0xF81F
+#define Col_Yellow   0xFFE0
+
+void write_pixel(int x, int y, short color);
+void clear_screen(int color);
+void tty_print(int x, int y, const char *text, int fg, int bg);
+void int_print(int x, int y, int value, int digits, int fg, int bg);
+void draw_hline(int x, int y, int length, int color);
+void draw_vline(int x, int y, int length, int color);
+void draw_filled_circle(int x, int y, int radius, int color);
+
+#endif /* DE10_LITE_VGA_DRIVER_H_ */
@@ -0,0 +1,16 @@
+#ifndef ALT_TYPES_H_
+#define ALT_TYPES_H_
+
+/* Host build: the HAL's fixed-width types */
+#include <stdint.h>
+
+typedef int8_t   alt_8;
+typedef uint8_t  alt_u8;
+typedef int16_t  alt_16;
+typedef uint16_t alt_u16;
+typedef int32_t  alt_32;
+typedef uint32_t alt_u32;
+typedef int64_t  alt_64;
+typedef uint64_t alt_u64;
+
+#endif /* ALT_TYPES_H_ */
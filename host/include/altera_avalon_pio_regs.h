@@ -0,0 +1,11 @@
+#ifndef ALTERA_AVALON_PIO_REGS_H_
+#define ALTERA_AVALON_PIO_REGS_H_
+
+#include "io.h"
+
+#define IORD_ALTERA_AVALON_PIO_DATA(base)            IORD(base, 0)
+#define IOWR_ALTERA_AVALON_PIO_DATA(base, data)      IOWR(base, 0, data)
+#define IOWR_ALTERA_AVALON_PIO_IRQ_MASK(base, data)  IOWR(base, 2, data)
+#define IOWR_ALTERA_AVALON_PIO_EDGE_CAP(base, data)  IOWR(base, 3, data)
+
+#endif /* ALTERA_AVALON_PIO_REGS_H_ */
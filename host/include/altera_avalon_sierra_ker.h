@@ -0,0 +1,31 @@
+#ifndef ALTERA_AVALON_SIERRA_KER_H_
+#define ALTERA_AVALON_SIERRA_KER_H_
+
+/*
+ * Host build: the Sierra API the application calls, implemented by the
+ * simulated kernel in sierra_sim.c.
+ */
+
+#define READY_TASK_STATE 1
+
+typedef union {
+    int periodic_start_integer;         // Bit 0: the period was overrun
+} task_periodic_start_union;
+
+void Sierra_Initiation_HW_and_SW(void);
+int sierra_HW_version(void);
+int sierra_SW_driver_version(void);
+void set_timebase(int time_base);
+
+void task_create(int task_id, int priority, int state, void (*entry)(void),
+                 char *stack, int stack_size);
+void init_period_time(int ticks);
+task_periodic_start_union wait_for_next_period(void);
+
+void sem_take(int sem);
+void sem_release(int sem);
+
+void tsw_on(void);
+void tsw_off(void);
+
+#endif /* ALTERA_AVALON_SIERRA_KER_H_ */
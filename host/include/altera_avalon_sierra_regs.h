@@ -0,0 +1,6 @@
+#ifndef ALTERA_AVALON_SIERRA_REGS_H_
+#define ALTERA_AVALON_SIERRA_REGS_H_
+
+/* Host build: nothing of this header is used by the application */
+
+#endif /* ALTERA_AVALON_SIERRA_REGS_H_ */
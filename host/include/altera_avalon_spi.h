@@ -0,0 +1,7 @@
+#ifndef ALTERA_AVALON_SPI_H_
+#define ALTERA_AVALON_SPI_H_
+
+/* Host build: ACC_SPI_BASE must stay undefined (adxl345_sim.c) */
+#include <alt_types.h>
+
+#endif /* ALTERA_AVALON_SPI_H_ */
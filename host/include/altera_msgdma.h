@@ -0,0 +1,11 @@
+#ifndef ALTERA_MSGDMA_H_
+#define ALTERA_MSGDMA_H_
+
+/*
+ * Host build: there is no mSGDMA, so VGA_MSGDMA_NAME and
+ * HOST_MSGDMA_NAME must stay undefined; dma.c then only needs these.
+ */
+#define ALTERA_MSGDMA_DESCRIPTOR_CONTROL_TRANSFER_COMPLETE_IRQ_MASK (1 << 14)
+#define ALTERA_MSGDMA_CSR_GLOBAL_INTERRUPT_MASK                     (1 << 4)
+
+#endif /* ALTERA_MSGDMA_H_ */
@@ -0,0 +1,13 @@
+#ifndef ALTERA_UP_AVALON_ACCELEROMETER_SPI_H_
+#define ALTERA_UP_AVALON_ACCELEROMETER_SPI_H_
+
+/* Host build: register access to the simulated ADXL345 (adxl345_sim.c) */
+#include <alt_types.h>
+
+typedef struct alt_up_accelerometer_spi_dev alt_up_accelerometer_spi_dev;
+
+alt_up_accelerometer_spi_dev *alt_up_accelerometer_spi_open_dev(const char *name);
+int alt_up_accelerometer_spi_read(alt_up_accelerometer_spi_dev *dev, alt_u8 addr, alt_u8 *data);
+int alt_up_accelerometer_spi_write(alt_up_accelerometer_spi_dev *dev, alt_u8 addr, alt_u8 data);
+
+#endif /* ALTERA_UP_AVALON_ACCELEROMETER_SPI_H_ */
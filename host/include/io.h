@@ -0,0 +1,21 @@
+#ifndef IO_H_
+#define IO_H_
+
+/* Host build: register accesses go to the simulated devices (sim.h) */
+#include <alt_types.h>
+
+alt_u32 sim_io_read(alt_u32 base, alt_u32 reg);
+void sim_io_write(alt_u32 base, alt_u32 reg, alt_u32 data);
+
+#define IORD(base, reg)        sim_io_read((base), (reg))
+#define IOWR(base, reg, data)  sim_io_write((base), (reg), (data))
+
+/* Byte-addressed stores; only the framebuffer (VGA_FB_BASE) uses them */
+void sim_io_write_direct(alt_u32 address, alt_u32 data, unsigned bytes);
+
+#define IOWR_16DIRECT(base, offset, data) \
+    sim_io_write_direct((alt_u32)(base) + (offset), (alt_u16)(data), 2)
+#define IOWR_32DIRECT(base, offset, data) \
+    sim_io_write_direct((alt_u32)(base) + (offset), (alt_u32)(data), 4)
+
+#endif /* IO_H_ */
@@ -0,0 +1,9 @@
+#ifndef ALT_CACHE_H_
+#define ALT_CACHE_H_
+
+/* Host build: no data cache to flush */
+#include <alt_types.h>
+
+static inline void alt_dcache_flush(void *start, alt_u32 length) { (void)start; (void)length; }
+
+#endif /* ALT_CACHE_H_ */
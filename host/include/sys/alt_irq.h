@@ -0,0 +1,14 @@
+#ifndef ALT_IRQ_H_
+#define ALT_IRQ_H_
+
+/* Host build: nothing preempts a simulated task, so these are no-ops */
+#include <alt_types.h>
+
+typedef alt_u32 alt_irq_context;
+
+static inline alt_irq_context alt_irq_disable_all(void) { return 0; }
+static inline void alt_irq_enable_all(alt_irq_context context) { (void)context; }
+
+int alt_ic_isr_register(alt_u32 ic_id, alt_u32 irq, void (*isr)(void *), void *context, void *flags);
+
+#endif /* ALT_IRQ_H_ */
@@ -0,0 +1,11 @@
+#ifndef ALT_TIMESTAMP_H_
+#define ALT_TIMESTAMP_H_
+
+/* Host build: simulated time (sierra_sim.c) */
+#include <alt_types.h>
+
+int alt_timestamp_start(void);
+alt_u32 alt_timestamp(void);
+alt_u32 alt_timestamp_freq(void);
+
+#endif /* ALT_TIMESTAMP_H_ */
@@ -0,0 +1,14 @@
+#ifndef SYSTEM_H_
+#define SYSTEM_H_
+
+/*
+ * Host build: the part of the Qsys-generated system.h the application
+ * uses. Only the push buttons exist; every optional peripheral of
+ * app_config.h stays undefined, so the driver-call paths are built.
+ */
+#define ALT_CPU_FREQ            50000000
+#define PIO_BUTTONS_IN_BASE     0x1000
+#define ACCELEROMETER_SPI_NAME  "/dev/accelerometer_spi"
+#define JTAG_UART_NAME          "/dev/stdout"
+
+#endif /* SYSTEM_H_ */
@@ -0,0 +1,125 @@
+/*
+ * Host replay of recorded accelerometer samples (see sim.h).
+ *
+ *   replay run <samples> [-t ticks] [-o screen.ppm]
+ *       Boot the application as on the board and feed it the samples
+ *       through the simulated ADXL345. Runs until every sample was
+ *       read and the tasks had time to draw it (or for the given
+ *       number of RTK ticks), then prints the console output, the task
+ *       statistics and the last motion analytics, and saves the screen.
+ *
+ *   replay filter <samples>
+ *       Run the samples through acc_filter_process() alone, as fast as
+ *       the host allows, and print the filtered output as x,y,z CSV.
+ *       The cost per input sample goes to stderr.
+ *
+ * <samples> is "x,y,z" per line or the CSV of tools/stream_receiver.py.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "acc_filter.h"
+#include "analytics.h"
+#include "log.h"
+#include "render.h"
+#include "sample_ring.h"
+#include "task_stats.h"
+#include "sim.h"
+
+int app_main();                         // main() of src/main.c
+
+static const char *screen_path = "screen.ppm";
+
+static void usage(void)
+{
+    fprintf(stderr,
+            "usage: replay run <samples> [-t ticks] [-o screen.ppm]\n"
+            "       replay filter <samples>\n");
+    exit(2);
+}
+
+void sim_finished(void)
+{
+    log_drain();
+    task_stats_dump();
+    analytics_report();
+    render_report();
+
+    if (!sim_screen_save(screen_path))
+        fprintf(stderr, "cannot write %s\n", screen_path);
+
+    fprintf(stderr, "%lu ticks (%lu ms), %s\n",
+            (unsigned long)sim_ticks(), (unsigned long)(sim_time_us() / 1000),
+            sim_replay_done() ? "all samples read" : "stopped early");
+    exit(0);
+}
+
+static int run_filter(void)
+{
+    static alt_16 block[AXIS_COUNT][FILTER_BLOCK] __attribute__((aligned(4)));
+    static alt_16 out[AXIS_COUNT][FILTER_BLOCK];
+    size_t total = sim_replay_count();
+    struct timespec start, end;
+    double elapsed_ns = 0;
+
+    acc_filter_init();
+
+    for (size_t done = 0; done < total; )
+    {
+        size_t count = total - done < FILTER_BLOCK ? total - done : FILTER_BLOCK;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const alt_16 *s = sim_replay_sample(done + i);
+
+            for (size_t a = 0; a < AXIS_COUNT; a++)
+                block[a][i] = s[a];
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        size_t produced = acc_filter_process(block, count, out);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        elapsed_ns += (end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec);
+
+        for (size_t i = 0; i < produced; i++)
+            printf("%d,%d,%d\n", out[AXIS_X][i], out[AXIS_Y][i], out[AXIS_Z][i]);
+
+        done += count;
+    }
+
+    fprintf(stderr, "%lu samples, %.1f ns per sample\n",
+            (unsigned long)total, total ? elapsed_ns / total : 0.0);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+        usage();
+
+    if (!sim_replay_load(argv[2]) || sim_replay_count() == 0)
+    {
+        fprintf(stderr, "no samples in %s\n", argv[2]);
+        return 1;
+    }
+
+    if (strcmp(argv[1], "filter") == 0)
+        return run_filter();
+
+    if (strcmp(argv[1], "run") != 0)
+        usage();
+
+    for (int i = 3; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            sim_set_end(strtoull(argv[++i], NULL, 0));
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            screen_path = argv[++i];
+        else
+            usage();
+    }
+
+    return app_main();                  // Does not return: sim_finished()
+}
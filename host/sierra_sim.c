@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <ucontext.h>
+#include "altera_avalon_sierra_ker.h"
+#include <sys/alt_irq.h>
+#include <sys/alt_timestamp.h>
+#include "system.h"
+#include "app_config.h"
+#include "sim.h"
+
+#define SIM_MAX_TASKS   16
+#define SIM_MAX_SEMS    16
+#define SIM_STACK_SIZE  (256 * 1024)    // Host frames are much larger
+#define SIM_IDLE        0
+
+typedef struct sim_task {
+    bool created;
+    int priority;
+    void (*entry)(void);
+    ucontext_t context;
+    alt_u32 period;                     // RTK ticks, 0 = not periodic
+    alt_u64 release;                    // Next release tick
+    bool waiting_period;
+    int waiting_sem;                    // -1 = none
+} sim_task_t;
+
+static sim_task_t tasks[SIM_MAX_TASKS];
+static int current = -1;                // -1 = start-up code in main()
+static ucontext_t scheduler;
+static bool sems_taken[SIM_MAX_SEMS];   // Binary semaphores, initially free
+static int switch_off;                  // tsw_off() nesting
+static bool started;
+
+static alt_u64 tick;
+static alt_u32 sub_tick;                // Timestamp reads within the tick
+static alt_u64 end_tick = ~(alt_u64)0;
+
+/* ================================================================
+ *                      SIMULATED TIME
+ * ================================================================ */
+#define TIMESTAMPS_PER_TICK ((alt_u64)SIM_TIMESTAMP_FREQ / 1000 * RTK_TICK_MS)
+
+alt_u64 sim_ticks(void)
+{
+    return tick;
+}
+
+alt_u64 sim_time_us(void)
+{
+    return tick * RTK_TICK_MS * 1000;
+}
+
+void sim_set_end(alt_u64 end)
+{
+    end_tick = end;
+}
+
+int alt_timestamp_start(void)
+{
+    return 0;
+}
+
+alt_u32 alt_timestamp_freq(void)
+{
+    return SIM_TIMESTAMP_FREQ;
+}
+
+static void yield(void);
+
+// Every read moves the clock a little so intervals are never zero; a
+// read from the idle task ends the tick, unless it holds a mutex
+alt_u32 alt_timestamp(void)
+{
+    if (started && current == SIM_IDLE && !switch_off)
+    {
+        tick++;
+        sub_tick = 0;
+
+        if (tick >= end_tick)
+            sim_finished();
+
+        yield();
+    }
+
+    if (sub_tick < TIMESTAMPS_PER_TICK - 1)
+        sub_tick++;
+
+    return (alt_u32)(tick * TIMESTAMPS_PER_TICK + sub_tick);
+}
+
+int alt_ic_isr_register(alt_u32 ic_id, alt_u32 irq, void (*isr)(void *), void *context, void *flags)
+{
+    (void)ic_id; (void)irq; (void)isr; (void)context; (void)flags;
+    return -1;                          // No interrupt sources
+}
+
+/* ================================================================
+ *                          SCHEDULER
+ *  Highest priority ready task first; a task runs until it waits.
+ *  Idle (priority 0) is always ready.
+ * ================================================================ */
+static bool ready(const sim_task_t *t)
+{
+    if (!t->created)
+        return false;
+    if (t->waiting_period && tick < t->release)
+        return false;
+    return t->waiting_sem < 0;
+}
+
+static int pick(void)
+{
+    int best = SIM_IDLE;
+
+    for (int i = 0; i < SIM_MAX_TASKS; i++)
+    {
+        if (ready(&tasks[i]) && tasks[i].priority > tasks[best].priority)
+            best = i;
+    }
+
+    return best;
+}
+
+static void yield(void)
+{
+    swapcontext(&tasks[current].context, &scheduler);
+}
+
+// A task woken by sem_release() with a higher priority runs first
+static void preempt(void)
+{
+    if (started && !switch_off && current >= 0 &&
+        tasks[pick()].priority > tasks[current].priority)
+        yield();
+}
+
+static void run(void)
+{
+    started = true;
+
+    while (1)
+    {
+        current = pick();
+
+        sim_task_t *t = &tasks[current];
+        if (t->waiting_period)
+        {
+            t->waiting_period = false;
+            t->release += t->period;
+        }
+
+        swapcontext(&scheduler, &t->context);
+    }
+}
+
+/* ================================================================
+ *                          SIERRA API
+ * ================================================================ */
+void Sierra_Initiation_HW_and_SW(void)
+{
+}
+
+int sierra_HW_version(void)
+{
+    return 0;
+}
+
+int sierra_SW_driver_version(void)
+{
+    return 0;
+}
+
+void set_timebase(int time_base)
+{
+    (void)time_base;                    // The tick is RTK_TICK_MS
+}
+
+void task_create(int task_id, int priority, int state, void (*entry)(void),
+                 char *stack, int stack_size)
+{
+    sim_task_t *t;
+
+    (void)state; (void)stack; (void)stack_size;
+
+    if (task_id < 0 || task_id >= SIM_MAX_TASKS)
+    {
+        fprintf(stderr, "sim: task id %d out of range\n", task_id);
+        exit(1);
+    }
+
+    t = &tasks[task_id];
+    t->created = true;
+    t->priority = priority;
+    t->entry = entry;
+    t->waiting_sem = -1;
+
+    getcontext(&t->context);
+    t->context.uc_stack.ss_sp = malloc(SIM_STACK_SIZE);
+    t->context.uc_stack.ss_size = SIM_STACK_SIZE;
+    t->context.uc_link = NULL;          // Task functions never return
+    makecontext(&t->context, entry, 0);
+}
+
+void init_period_time(int ticks)
+{
+    sim_task_t *t = &tasks[current];
+
+    t->period = ticks;
+    t->release = tick + ticks;
+}
+
+task_periodic_start_union wait_for_next_period(void)
+{
+    task_periodic_start_union result = { 0 };
+    sim_task_t *t = &tasks[current];
+
+    // Jobs take no simulated time, so a period is never overrun
+    t->waiting_period = true;
+    yield();
+
+    return result;
+}
+
+void sem_take(int sem)
+{
+    if (!sems_taken[sem])
+    {
+        sems_taken[sem] = true;
+        return;
+    }
+
+    tasks[current].waiting_sem = sem;
+    yield();                            // Ownership is handed over on release
+}
+
+void sem_release(int sem)
+{
+    int next = -1;
+
+    for (int i = 0; i < SIM_MAX_TASKS; i++)
+    {
+        if (tasks[i].waiting_sem == sem &&
+            (next < 0 || tasks[i].priority > tasks[next].priority))
+            next = i;
+    }
+
+    if (next < 0)
+    {
+        sems_taken[sem] = false;
+        return;
+    }
+
+    tasks[next].waiting_sem = -1;
+    preempt();
+}
+
+void tsw_on(void)
+{
+    if (!started)
+    {
+        run();                          // Start multitasking; never returns
+    }
+
+    if (switch_off > 0)
+        switch_off--;
+}
+
+void tsw_off(void)
+{
+    switch_off++;
+}
@@ -0,0 +1,52 @@
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <alt_types.h>
+#include "system.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  HOST SIMULATION
+ * ---------------------------------------------------------------------
+ *  The application sources are built unchanged against the headers in
+ *  host/include, whose functions are implemented here:
+ *
+ *   sierra_sim.c   Sierra tasks on ucontext coroutines, run by priority
+ *                  on a simulated RTK tick. Jobs take no simulated time:
+ *                  the clock only moves when the idle task runs, one
+ *                  tick per idle pass. Scheduling is therefore exact,
+ *                  but execution times and CPU load are not.
+ *   adxl345_sim.c  ADXL345 register file whose FIFO fills from the
+ *                  replayed samples at the configured output data rate
+ *   board_sim.c    320x240 RGB565 screen behind the VGA driver calls,
+ *                  saved as a PPM image, and the push buttons (never
+ *                  pressed once start-up has passed the welcome screen)
+ *   replay.c       main(): replays a sample file through the whole
+ *                  application, or through the filter chain alone
+ * ---------------------------------------------------------------------
+ */
+
+#define SIM_TIMESTAMP_FREQ  ALT_CPU_FREQ
+
+// Simulated time since start-up
+alt_u64 sim_ticks(void);                // RTK ticks
+alt_u64 sim_time_us(void);
+
+// Stop the simulation at this tick (checked on every tick)
+void sim_set_end(alt_u64 tick);
+
+// Called once the simulation stops; does not return
+void sim_finished(void);
+
+// Samples (x, y, z counts) the simulated ADXL345 delivers in order
+bool sim_replay_load(const char *path);
+size_t sim_replay_count(void);
+const alt_16 *sim_replay_sample(size_t index);
+bool sim_replay_done(void);             // Every sample was read
+
+// Save the simulated screen as binary PPM
+bool sim_screen_save(const char *path);
+
+#endif /* SIM_H_ */
@@ -0,0 +1,98 @@
+#include <stdint.h>
+#include "acc_filter.h"
+#include "hot.h"
+
+// 15-tap Hamming-windowed low-pass, cutoff fs/8, unity DC gain (Q15)
+static const q15_t fir_lowpass[15] = {
+      -84,  -219,  -374,     0,  1582,  4321,  7054,  8208,
+     7054,  4321,  1582,     0,  -374,  -219,   -84
+};
+
+// Butterworth low-pass, cutoff 0.05 fs of the decimated rate (Q14)
+#define BIQUAD_B0     329
+#define BIQUAD_B1     658
+#define BIQUAD_B2     329
+#define BIQUAD_A1  (-25576)
+#define BIQUAD_A2   10508
+
+typedef struct axis_chain {
+    median_t median;
+    fir_t fir;
+    decimator_t decimator;
+    biquad_t biquad;
+    filter_stage_t stages[4];
+    filter_pipeline_t pipeline;
+} axis_chain_t;
+
+static axis_chain_t chains[AXIS_COUNT] HOT_DATA;
+
+void acc_filter_init(void)
+{
+    for (size_t a = 0; a < AXIS_COUNT; a++)
+    {
+        axis_chain_t *c = &chains[a];
+
+        median_init(&c->median, 5);
+        fir_init(&c->fir, fir_lowpass, sizeof(fir_lowpass) / sizeof(fir_lowpass[0]));
+        decimator_init(&c->decimator, FILTER_DECIMATION);
+        biquad_init(&c->biquad, BIQUAD_B0, BIQUAD_B1, BIQUAD_B2, BIQUAD_A1, BIQUAD_A2);
+
+        c->stages[0] = (filter_stage_t){ median_process, &c->median };
+        c->stages[1] = (filter_stage_t){ fir_process, &c->fir };
+        c->stages[2] = (filter_stage_t){ decimator_process, &c->decimator };
+        c->stages[3] = (filter_stage_t){ biquad_process, &c->biquad };
+
+        filter_pipeline_init(&c->pipeline, c->stages, 4);
+    }
+}
+
+/* ================================================================
+ *                      INPUT SCALING
+ *  Two samples per 32-bit word: shifting the word moves both lanes,
+ *  and the bits the low lane pushes into the high one are masked off.
+ *  Gives the same truncated int16 results as the scalar loop.
+ * ================================================================ */
+#define Q15_PAIR_MASK (~(((1u << FILTER_INPUT_SHIFT) - 1) << 16))
+
+// A word that may alias the int16 samples: plain alt_u32 accesses to
+// them break strict aliasing, and -O2 may reorder them against the
+// q15_t accesses of the pipeline
+typedef alt_u32 __attribute__((may_alias)) q15_pair_t;
+
+static HOT_CODE void scale_to_q15(const alt_16 *in, q15_t *out, size_t count)
+{
+    size_t i = 0;
+
+    if ((((uintptr_t)in | (uintptr_t)out) & 0x3) == 0)
+    {
+        const q15_pair_t *win = (const q15_pair_t *)in;
+        q15_pair_t *wout = (q15_pair_t *)out;
+
+        for (; i + 1 < count; i += 2)
+            *wout++ = (*win++ << FILTER_INPUT_SHIFT) & Q15_PAIR_MASK;
+    }
+
+    for (; i < count; i++)
+        out[i] = in[i] * (1 << FILTER_INPUT_SHIFT);
+}
+
+HOT_CODE size_t acc_filter_process(const alt_16 in[AXIS_COUNT][FILTER_BLOCK], size_t count,
+                                   alt_16 out[AXIS_COUNT][FILTER_BLOCK])
+{
+    static q15_t block[FILTER_BLOCK] HOT_DATA __attribute__((aligned(4)));
+    size_t produced = 0;
+
+    if (count > FILTER_BLOCK)
+        count = FILTER_BLOCK;
+
+    for (size_t a = 0; a < AXIS_COUNT; a++)
+    {
+        scale_to_q15(in[a], block, count);
+        produced = filter_pipeline_run(&chains[a].pipeline, block, out[a], count);
+
+        for (size_t i = 0; i < produced; i++)
+            out[a][i] >>= FILTER_INPUT_SHIFT;
+    }
+
+    return produced;
+}
@@ -0,0 +1,32 @@
+#ifndef ACC_FILTER_H_
+#define ACC_FILTER_H_
+
+#include <stddef.h>
+#include "filter_pipeline.h"
+#include "position.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  ACCELEROMETER FILTER CHAIN
+ * ---------------------------------------------------------------------
+ *  One pipeline per axis:
+ *      median-of-5  ->  FIR low-pass  ->  decimate  ->  biquad low-pass
+ *  Raw counts are scaled to Q15 by FILTER_INPUT_SHIFT on the way in
+ *  and back to counts on the way out. The FIR stage of all three axes
+ *  runs on the mac_fir_block() kernel.
+ *
+ *  Blocks are structure-of-arrays: each stage walks one contiguous
+ *  array per axis. The input scaling shifts two samples per 32-bit
+ *  word when the arrays are word aligned.
+ * ---------------------------------------------------------------------
+ */
+
+void acc_filter_init(void);
+
+// Filter a block of raw counts, one array per axis (count <=
+// FILTER_BLOCK, see sample_ring_read_axes()). Writes the decimated
+// output of each axis to out[axis] and returns its length.
+size_t acc_filter_process(const alt_16 in[AXIS_COUNT][FILTER_BLOCK], size_t count,
+                          alt_16 out[AXIS_COUNT][FILTER_BLOCK]);
+
+#endif /* ACC_FILTER_H_ */
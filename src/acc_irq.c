@@ -0,0 +1,109 @@
+#include <stddef.h>
+#include "altera_avalon_sierra_ker.h"
+#include <altera_avalon_pio_regs.h>
+#include <sys/alt_irq.h>
+#include <sys/alt_timestamp.h>
+#include "system.h"
+#include "acc_irq.h"
+#include "adxl345.h"
+#include "hot.h"
+#include "trace.h"
+
+#ifdef ACC_INT_PIO_BASE
+
+static volatile alt_u32 irq_timestamp HOT_DATA;
+static volatile alt_u32 irq_count HOT_DATA;    // Written by the ISR only
+static alt_u32 handled_count HOT_DATA;         // Written by the task only
+static volatile bool irq_armed HOT_DATA;       // Unmasked, ISR not run yet
+
+/* ================================================================
+ *                          TOP HALF
+ * ================================================================ */
+static HOT_CODE void acc_int1_isr(void *context)
+{
+    (void)context;
+
+    irq_timestamp = alt_timestamp();
+    irq_count++;
+    irq_armed = false;
+
+    // INT1 stays high until the FIFO is drained below the watermark.
+    // From here on the PIO captures the next rising edge, including
+    // one during the drain, and only the next acc_irq_rearm() unmasks
+    // it.
+    IOWR_ALTERA_AVALON_PIO_IRQ_MASK(ACC_INT_PIO_BASE, 0);
+    IOWR_ALTERA_AVALON_PIO_EDGE_CAP(ACC_INT_PIO_BASE, ACC_INT_PIO_MASK);
+
+    trace_sem_release(TRACE_TASK_ISR, SEM_ACC_DATA);
+}
+
+bool acc_irq_init(void)
+{
+    IOWR_ALTERA_AVALON_PIO_IRQ_MASK(ACC_INT_PIO_BASE, 0);
+    IOWR_ALTERA_AVALON_PIO_EDGE_CAP(ACC_INT_PIO_BASE, ACC_INT_PIO_MASK);
+
+    return alt_ic_isr_register(ACC_INT_PIO_IRQ_INTERRUPT_CONTROLLER_ID,
+                               ACC_INT_PIO_IRQ, acc_int1_isr, NULL, NULL) == 0;
+}
+
+/* ================================================================
+ *                        BOTTOM HALF
+ *  The edge is not cleared again when re-arming: it was cleared by
+ *  the ISR, and an edge captured since then (the FIFO refilled to the
+ *  watermark during the drain) must still fire. The PIO misses one
+ *  case: new entries keep the FIFO at the watermark through the end
+ *  of the drain (adxl345_read_fifo() pops the count it read first),
+ *  so INT1 never goes low and is already high when unmasked.
+ *  Rearming reads the FIFO level after the unmask to catch it, and
+ *  then does the ISR's work itself.
+ * ================================================================ */
+bool acc_irq_fetch(alt_u32 *timestamp)
+{
+    alt_u32 count = irq_count;
+
+    if (count == handled_count)
+        return false;
+
+    // The ISR is masked until acc_irq_rearm(), so the pair is stable
+    *timestamp = irq_timestamp;
+    handled_count = count;
+    return true;
+}
+
+void acc_irq_rearm(void)
+{
+    alt_irq_context ctx;
+    size_t entries;
+
+    irq_armed = true;
+    IOWR_ALTERA_AVALON_PIO_IRQ_MASK(ACC_INT_PIO_BASE, ACC_INT_PIO_MASK);
+
+    entries = adxl345_fifo_entries();
+    if (entries < ACC_FIFO_WATERMARK)
+        return;                 // INT1 is low: the next crossing is an edge
+
+    ctx = alt_irq_disable_all();
+
+    // The interrupt fired after the unmask and has been posted
+    if (!irq_armed)
+    {
+        alt_irq_enable_all(ctx);
+        return;
+    }
+
+    // Any edge captured so far is covered by the drain this posts
+    IOWR_ALTERA_AVALON_PIO_IRQ_MASK(ACC_INT_PIO_BASE, 0);
+    IOWR_ALTERA_AVALON_PIO_EDGE_CAP(ACC_INT_PIO_BASE, ACC_INT_PIO_MASK);
+    irq_armed = false;
+
+    // Date it like the ISR: when the watermark entry was written,
+    // entries - ACC_FIFO_WATERMARK output-data-rate periods ago
+    irq_timestamp = alt_timestamp() -
+                    (alt_u32)(entries - ACC_FIFO_WATERMARK) * (alt_timestamp_freq() / ACC_ODR_HZ);
+    irq_count++;
+    alt_irq_enable_all(ctx);
+
+    trace_sem_release(TRACE_TASK_UNKNOWN, SEM_ACC_DATA);
+}
+
+#endif /* ACC_INT_PIO_BASE */
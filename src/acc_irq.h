@@ -0,0 +1,44 @@
+#ifndef ACC_IRQ_H_
+#define ACC_IRQ_H_
+
+#include <stdbool.h>
+#include <alt_types.h>
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  ACCELEROMETER WATERMARK INTERRUPT
+ * ---------------------------------------------------------------------
+ *  Only built with ACC_INT_PIO_BASE, the edge-capture PIO wired to the
+ *  ADXL345 INT1 pin. The ISR is the top half: it timestamps the
+ *  moment the FIFO reached ACC_FIFO_WATERMARK entries, masks itself
+ *  and releases SEM_ACC_DATA. The acquisition task is the bottom
+ *  half: it drains the FIFO over SPI, dates every entry from the ISR
+ *  timestamp and re-arms the interrupt, so no SPI traffic happens in
+ *  interrupt context and sample times do not depend on when the task
+ *  gets the CPU. The Sierra sem_release() must be callable from
+ *  interrupt context.
+ * ---------------------------------------------------------------------
+ */
+
+#ifdef ACC_INT_PIO_BASE
+
+// Register the ISR; the interrupt stays masked until acc_irq_rearm()
+bool acc_irq_init(void);
+
+// After SEM_ACC_DATA was taken: store the timestamp of the interrupt
+// not handled yet. Returns false for a wake-up without a new interrupt
+// (e.g. the semaphore's initial count).
+bool acc_irq_fetch(alt_u32 *timestamp);
+
+// Unmask the interrupt after draining. INT1 is a level and the PIO
+// only sees rising edges, so this reads the FIFO level again: when it
+// is already back at ACC_FIFO_WATERMARK no edge will come, and
+// rearming masks the interrupt again and releases SEM_ACC_DATA itself,
+// with a timestamp as the ISR would have taken. Task context only
+// (SPI access).
+void acc_irq_rearm(void);
+
+#endif /* ACC_INT_PIO_BASE */
+
+#endif /* ACC_IRQ_H_ */
@@ -0,0 +1,146 @@
+#include "app_config.h"
+#include "adxl345.h"
+#include "hot.h"
+
+#ifdef ACC_SPI_BASE
+#include <altera_avalon_spi.h>
+#else
+#include <altera_up_avalon_accelerometer_spi.h>
+#endif
+
+// SPI command byte flags
+#define ADXL345_SPI_READ        0x80
+#define ADXL345_SPI_MULTIBYTE   0x40
+
+/* ================================================================
+ *                      REGISTER ACCESS
+ *  Generic SPI master: every call is a single chip-select cycle,
+ *  including multi-byte reads.
+ *  University Program core: one core access per register.
+ * ================================================================ */
+#ifdef ACC_SPI_BASE
+
+bool adxl345_open(void)
+{
+    return true;
+}
+
+bool adxl345_read_regs(alt_u8 reg, alt_u8 *values, size_t count)
+{
+    alt_u8 cmd = reg | ADXL345_SPI_READ | (count > 1 ? ADXL345_SPI_MULTIBYTE : 0);
+
+    return alt_avalon_spi_command(ACC_SPI_BASE, ACC_SPI_SLAVE,
+                                  1, &cmd, count, values, 0) == (int)count;
+}
+
+bool adxl345_write_reg(alt_u8 reg, alt_u8 value)
+{
+    alt_u8 cmd[2] = { reg, value };
+
+    return alt_avalon_spi_command(ACC_SPI_BASE, ACC_SPI_SLAVE,
+                                  2, cmd, 0, NULL, 0) == 0;
+}
+
+#else
+
+static alt_up_accelerometer_spi_dev *acc_dev;
+
+bool adxl345_open(void)
+{
+    acc_dev = alt_up_accelerometer_spi_open_dev(ACC_SPI_DEV_NAME);
+    return acc_dev != NULL;
+}
+
+bool adxl345_read_regs(alt_u8 reg, alt_u8 *values, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        if (alt_up_accelerometer_spi_read(acc_dev, reg + i, &values[i]) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+bool adxl345_write_reg(alt_u8 reg, alt_u8 value)
+{
+    return alt_up_accelerometer_spi_write(acc_dev, reg, value) == 0;
+}
+
+#endif /* ACC_SPI_BASE */
+
+bool adxl345_read_reg(alt_u8 reg, alt_u8 *value)
+{
+    return adxl345_read_regs(reg, value, 1);
+}
+
+/* ================================================================
+ *                      CONFIGURATION
+ * ================================================================ */
+static alt_u8 rate_code(unsigned int odr_hz)
+{
+    // BW_RATE codes double the rate per step: 0x0A = 100 Hz
+    alt_u8 code = 0x0A;
+    unsigned int rate = 100;
+
+    while (rate < odr_hz && code < 0x0F)
+    {
+        rate <<= 1;
+        code++;
+    }
+
+    return code;
+}
+
+bool adxl345_configure_stream(unsigned int odr_hz)
+{
+    return adxl345_write_reg(ADXL345_BW_RATE, rate_code(odr_hz)) &&
+           // Stream mode, watermark at ACC_FIFO_WATERMARK entries
+           adxl345_write_reg(ADXL345_FIFO_CTL, 0x80 | ACC_FIFO_WATERMARK) &&
+           // Watermark interrupt on INT1
+           adxl345_write_reg(ADXL345_INT_MAP, 0x00) &&
+           adxl345_write_reg(ADXL345_INT_ENABLE, ADXL345_INT_WATERMARK);
+}
+
+size_t adxl345_fifo_entries(void)
+{
+    alt_u8 status;
+
+    if (!adxl345_read_reg(ADXL345_FIFO_STATUS, &status))
+        return 0;
+
+    return status & 0x3F;
+}
+
+/* ================================================================
+ *                      SAMPLE READ
+ *  One six-byte read of DATAX0..DATAZ1 pops one FIFO entry. The
+ *  ADXL345 only pops on the end of a data-register read, so every
+ *  entry needs its own (burst) transaction.
+ * ================================================================ */
+bool adxl345_read_sample(position_t *pos)
+{
+    alt_u8 raw[6];
+
+    if (!adxl345_read_regs(ADXL345_DATAX0, raw, sizeof(raw)))
+        return false;
+
+    pos->x = (int16_t)(raw[0] | (raw[1] << 8));
+    pos->y = (int16_t)(raw[2] | (raw[3] << 8));
+    pos->z = (int16_t)(raw[4] | (raw[5] << 8));
+    return true;
+}
+
+HOT_CODE size_t adxl345_read_fifo(position_t *out, size_t max)
+{
+    size_t entries = adxl345_fifo_entries();
+    size_t count = 0;
+
+    if (entries > max)
+        entries = max;
+
+    while (count < entries && adxl345_read_sample(&out[count]))
+        count++;
+
+    return count;
+}
@@ -0,0 +1,53 @@
+#ifndef ADXL345_H_
+#define ADXL345_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "position.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  ADXL345 REGISTER ACCESS
+ * ---------------------------------------------------------------------
+ *  Direct register access to the DE10-Lite G-sensor, next to the
+ *  accelerometer_* calls of DE10_Lite_Arduino_Driver (which still do
+ *  the power-up configuration). Used to run the sensor at its own
+ *  output data rate with the on-chip FIFO enabled.
+ * ---------------------------------------------------------------------
+ */
+
+// Register map (subset)
+#define ADXL345_BW_RATE      0x2C
+#define ADXL345_POWER_CTL    0x2D
+#define ADXL345_INT_ENABLE   0x2E
+#define ADXL345_INT_MAP      0x2F
+#define ADXL345_INT_SOURCE   0x30
+#define ADXL345_DATA_FORMAT  0x31
+#define ADXL345_DATAX0       0x32
+#define ADXL345_FIFO_CTL     0x38
+#define ADXL345_FIFO_STATUS  0x39
+
+#define ADXL345_FIFO_DEPTH   32
+
+#define ADXL345_INT_WATERMARK 0x02  // INT_ENABLE / INT_SOURCE bit
+
+bool adxl345_open(void);
+bool adxl345_read_reg(alt_u8 reg, alt_u8 *value);
+bool adxl345_read_regs(alt_u8 reg, alt_u8 *values, size_t count);
+bool adxl345_write_reg(alt_u8 reg, alt_u8 value);
+
+// Select the output data rate, put the FIFO in stream mode and raise
+// INT1 once ACC_FIFO_WATERMARK entries are queued
+bool adxl345_configure_stream(unsigned int odr_hz);
+
+// Number of complete samples waiting in the FIFO
+size_t adxl345_fifo_entries(void);
+
+// Pop one sample from the FIFO (or the data registers in bypass mode)
+bool adxl345_read_sample(position_t *pos);
+
+// Drain up to max FIFO entries with one status read and one burst read
+// per entry; returns the number of samples stored in out
+size_t adxl345_read_fifo(position_t *out, size_t max);
+
+#endif /* ADXL345_H_ */
@@ -0,0 +1,212 @@
+#include "analytics.h"
+#include "hot.h"
+#include "log.h"
+
+#if ANALYTICS_THRESHOLD <= ANALYTICS_HYSTERESIS || ANALYTICS_THRESHOLD > 32767
+#error "ANALYTICS_THRESHOLD must be above ANALYTICS_HYSTERESIS and at most 32767"
+#endif
+
+#define THRESHOLD_SQ ((alt_u32)ANALYTICS_THRESHOLD * ANALYTICS_THRESHOLD)
+#define REARM_SQ     ((alt_u32)(ANALYTICS_THRESHOLD - ANALYTICS_HYSTERESIS) * \
+                      (ANALYTICS_THRESHOLD - ANALYTICS_HYSTERESIS))
+
+motion_lock_t motion_data HOT_DATA;
+
+static struct {
+    alt_u32 count;                      // Samples in the current window
+    alt_32 sum[AXIS_COUNT];
+    alt_u64 sum_sq[AXIS_COUNT];
+    alt_16 min[AXIS_COUNT];
+    alt_16 max[AXIS_COUNT];
+    bool above;                         // |a| above the threshold
+    motion_t out;
+} state HOT_DATA;
+
+/* ================================================================
+ *                          CORDIC
+ *  Vectoring mode: the vector is rotated onto the positive x axis in
+ *  16 shift-and-add steps while the rotation angles are summed. The
+ *  angles are atan(2^-i) in degrees, Q16; the final x is the length
+ *  times the CORDIC gain 1/0.60725. Inputs are int16 means scaled by
+ *  1 << CORDIC_SHIFT, which leaves room for the gain and for sqrt(2).
+ * ================================================================ */
+#define CORDIC_STEPS 16
+#define CORDIC_SHIFT 12
+#define CORDIC_INV_GAIN 39797           // 0.60725 in Q16
+#define DEG_Q16(d) ((alt_32)(d) << 16)
+
+static const alt_32 atan_table[CORDIC_STEPS] = {
+    2949120, 1740967, 919879, 466945, 234379, 117304, 58666, 29335,
+      14668,    7334,   3667,   1833,    917,    458,   229,   115
+};
+
+// Rotate (x, y), scaled by 1 << CORDIC_SHIFT, onto the positive x
+// axis. Returns its angle in Q16 degrees, -180..180, and leaves the
+// length times the CORDIC gain in *x.
+static alt_32 cordic_vector(alt_32 *px, alt_32 *py)
+{
+    alt_32 x = *px, y = *py;
+    alt_32 angle = 0;
+
+    // Bring the vector into the right half-plane first
+    if (x < 0)
+    {
+        angle = y >= 0 ? DEG_Q16(180) : -DEG_Q16(180);
+        x = -x;
+        y = -y;
+    }
+
+    for (int i = 0; i < CORDIC_STEPS; i++)
+    {
+        alt_32 dx = y >> i;
+        alt_32 dy = x >> i;
+
+        if (y > 0)
+        {
+            x += dx;
+            y -= dy;
+            angle += atan_table[i];
+        }
+        else
+        {
+            x -= dx;
+            y += dy;
+            angle -= atan_table[i];
+        }
+    }
+
+    *px = x;
+    *py = y;
+    return angle;
+}
+
+// Q16 degrees to 1/100 degree, rounded
+static alt_16 centidegrees(alt_32 angle)
+{
+    return (alt_16)(((alt_64)angle * 100 + (1 << 15)) >> 16);
+}
+
+// floor(sqrt(v)), one result bit per step
+static alt_u32 isqrt64(alt_u64 v)
+{
+    alt_u32 root = 0;
+
+    for (int bit = 31; bit >= 0; bit--)
+    {
+        alt_u32 trial = root | (1u << bit);
+
+        if ((alt_u64)trial * trial <= v)
+            root = trial;
+    }
+
+    return root;
+}
+
+/* ================================================================
+ *                          WINDOWS
+ * ================================================================ */
+static void window_reset(void)
+{
+    state.count = 0;
+
+    for (size_t a = 0; a < AXIS_COUNT; a++)
+    {
+        state.sum[a] = 0;
+        state.sum_sq[a] = 0;
+        state.min[a] = 32767;
+        state.max[a] = -32768;
+    }
+}
+
+static void window_publish(void)
+{
+    motion_t *out = &state.out;
+    alt_32 mean[AXIS_COUNT];
+
+    for (size_t a = 0; a < AXIS_COUNT; a++)
+    {
+        // N^2 * variance = N * sum(v^2) - sum(v)^2, exact in 64 bits
+        alt_u64 spread = (state.sum_sq[a] << ANALYTICS_WINDOW_LOG2) -
+                         (alt_u64)((alt_64)state.sum[a] * state.sum[a]);
+
+        out->rms[a] = (alt_u16)(isqrt64(spread) >> ANALYTICS_WINDOW_LOG2);
+        out->peak_to_peak[a] = (alt_u16)(state.max[a] - state.min[a]);
+        mean[a] = state.sum[a] >> ANALYTICS_WINDOW_LOG2;
+    }
+
+    // Roll from (z, y); its length |(y, z)| keeps the input scaling so
+    // small vectors do not lose the pitch to rounding
+    alt_32 x = mean[AXIS_Z] * (1 << CORDIC_SHIFT);
+    alt_32 y = mean[AXIS_Y] * (1 << CORDIC_SHIFT);
+    out->roll = centidegrees(cordic_vector(&x, &y));
+
+    x = (alt_32)(((alt_64)x * CORDIC_INV_GAIN) >> 16);
+    y = -mean[AXIS_X] * (1 << CORDIC_SHIFT);
+    out->pitch = centidegrees(cordic_vector(&x, &y));
+    out->windows++;
+
+    seqlock_write(&motion_data, *out);
+    window_reset();
+}
+
+void analytics_init(void)
+{
+    state.above = false;
+    state.out = (motion_t){ { 0 }, { 0 }, 0, 0, 0, 0 };
+    window_reset();
+}
+
+HOT_CODE void analytics_process(const alt_16 in[AXIS_COUNT][FILTER_BLOCK], size_t count)
+{
+    if (count > FILTER_BLOCK)
+        count = FILTER_BLOCK;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        alt_u32 magnitude_sq = 0;
+
+        for (size_t a = 0; a < AXIS_COUNT; a++)
+        {
+            alt_16 v = in[a][i];
+            alt_u32 sq = (alt_u32)((alt_32)v * v);
+
+            state.sum[a] += v;
+            state.sum_sq[a] += sq;
+            magnitude_sq += sq;
+
+            if (v < state.min[a])
+                state.min[a] = v;
+            if (v > state.max[a])
+                state.max[a] = v;
+        }
+
+        if (!state.above && magnitude_sq > THRESHOLD_SQ)
+        {
+            state.above = true;
+            state.out.events++;
+            LOG("Motion event %u: |a| above %u counts\n", state.out.events, ANALYTICS_THRESHOLD);
+        }
+        else if (state.above && magnitude_sq < REARM_SQ)
+        {
+            state.above = false;
+        }
+
+        if (++state.count == ANALYTICS_WINDOW)
+            window_publish();
+    }
+}
+
+/* ================================================================
+ *                           REPORT
+ * ================================================================ */
+void analytics_report(void)
+{
+    motion_t m;
+
+    seqlock_read(&motion_data, &m);
+
+    console_printf("motion rms %u %u %u  p2p %u %u %u  pitch %d roll %d (1/100 deg)  events %lu\n",
+                   m.rms[AXIS_X], m.rms[AXIS_Y], m.rms[AXIS_Z],
+                   m.peak_to_peak[AXIS_X], m.peak_to_peak[AXIS_Y], m.peak_to_peak[AXIS_Z],
+                   m.pitch, m.roll, (unsigned long)m.events);
+}
@@ -0,0 +1,56 @@
+#ifndef ANALYTICS_H_
+#define ANALYTICS_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <alt_types.h>
+#include "app_config.h"
+#include "position.h"
+#include "seqlock.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  MOTION ANALYTICS
+ * ---------------------------------------------------------------------
+ *  Runs over the raw samples of the filter task's blocks, in tumbling
+ *  windows of ANALYTICS_WINDOW samples. Each sample costs a fixed
+ *  handful of adds, multiplies and compares; at the end of a window
+ *  the results are derived in constant time and published through
+ *  motion_data:
+ *
+ *    rms           per-axis RMS about the window mean (vibration)
+ *    peak_to_peak  per-axis max - min
+ *    pitch, roll   tilt of the window mean (the gravity vector),
+ *                  from an integer CORDIC instead of libm
+ *    events        times |a| rose above ANALYTICS_THRESHOLD; it must
+ *                  fall ANALYTICS_HYSTERESIS below before the next one
+ *
+ *  Every event is also LOG()ged.
+ * ---------------------------------------------------------------------
+ */
+
+#define ANALYTICS_WINDOW (1u << ANALYTICS_WINDOW_LOG2)
+
+typedef struct motion {
+    alt_u16 rms[AXIS_COUNT];            // Counts
+    alt_u16 peak_to_peak[AXIS_COUNT];   // Counts
+    alt_16 pitch;                       // 1/100 degree, -9000..9000
+    alt_16 roll;                        // 1/100 degree, -18000..18000
+    alt_u32 events;                     // Threshold crossings so far
+    alt_u32 windows;                    // Windows completed so far
+} motion_t;
+
+typedef SEQLOCK(motion_t) motion_lock_t;
+
+// Latest results (written by the filter task only)
+extern motion_lock_t motion_data;
+
+void analytics_init(void);
+
+// Feed a block of raw counts, one array per axis
+void analytics_process(const alt_16 in[AXIS_COUNT][FILTER_BLOCK], size_t count);
+
+// Print the latest results to the console
+void analytics_report(void);
+
+#endif /* ANALYTICS_H_ */
@@ -0,0 +1,485 @@
+#ifndef APP_CONFIG_H_
+#define APP_CONFIG_H_
+
+/*
+ * ---------------------------------------------------------------------
+ *  BUILD-TIME CONFIGURATION
+ * ---------------------------------------------------------------------
+ *  Every option has a default here and can be overridden from the
+ *  Makefile (APP_CFLAGS_DEFINED_SYMBOLS += -D<OPTION>=<value>).
+ * ---------------------------------------------------------------------
+ */
+
+/* --------------------------- STARTUP ------------------------------- */
+
+// Headless boot: no welcome screen and no wait for a button press
+#ifndef HEADLESS_BOOT
+#define HEADLESS_BOOT 0
+#endif
+
+// Switch PIO read at reset: with BOOT_SWITCH_MASK set the board boots
+// headless even when HEADLESS_BOOT is 0
+// #define BOOT_SWITCH_PIO_BASE PIO_SWITCHES_IN_BASE
+
+#ifndef BOOT_SWITCH_MASK
+#define BOOT_SWITCH_MASK 0x1
+#endif
+
+// Accelerometer bring-up attempts at boot. The wait between attempts
+// starts at ACC_BOOT_BACKOFF_US and doubles; after the last one the
+// system runs without samples.
+#ifndef ACC_BOOT_ATTEMPTS
+#define ACC_BOOT_ATTEMPTS 6
+#endif
+
+#ifndef ACC_BOOT_BACKOFF_US
+#define ACC_BOOT_BACKOFF_US 1000    // 31 ms of waiting at most
+#endif
+
+/* ---------------------------- KERNEL ------------------------------- */
+
+#ifndef RTK_TICK_MS
+#define RTK_TICK_MS 20          // Sierra time base set in main()
+#endif
+
+// Task periods in RTK ticks (the ACC, RENDER and PLOT periods are
+// configured in their own sections); see the task table in tasks.h
+#ifndef TIMER_PERIOD_TICKS
+#define TIMER_PERIOD_TICKS 50   // 1 s
+#endif
+
+#ifndef ACC_FILTER_PERIOD_TICKS
+#define ACC_FILTER_PERIOD_TICKS 50
+#endif
+
+#ifndef IDLE_STACK_SIZE
+#define IDLE_STACK_SIZE 1024    // Idle runs printf (log drain, dumps)
+#endif
+
+// Idle loop (idle.h): nops per spin pass, longest pass still counted
+// as idle, and how often background work runs (also debounces keys)
+#ifndef IDLE_SPIN_LOOPS
+#define IDLE_SPIN_LOOPS 32
+#endif
+
+#ifndef IDLE_GAP_US
+#define IDLE_GAP_US 20
+#endif
+
+#ifndef IDLE_WORK_US
+#define IDLE_WORK_US 20000
+#endif
+
+#ifndef TASK_STATS_MAX
+#define TASK_STATS_MAX 8        // Tasks that can register timing statistics
+#endif
+
+#ifndef MUTEX_MAX
+#define MUTEX_MAX 4             // Mutexes listed by mutex_report()
+#endif
+
+// Longest console_mutex section: one non-blocking write() of at most
+// CONSOLE_LINE_MAX bytes into the JTAG UART driver's buffer (log.h).
+// mutex_report() flags a measured hold above it.
+#ifndef CONSOLE_CS_US
+#define CONSOLE_CS_US 300
+#endif
+
+// Longest mutex section of the idle task (console output only),
+// blocking time of every task in the response-time analysis
+#ifndef IDLE_CS_US
+#define IDLE_CS_US CONSOLE_CS_US
+#endif
+
+// Scheduling event trace (trace.h); cheap enough to leave enabled
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE 1
+#endif
+
+#ifndef TRACE_RING_SIZE
+#define TRACE_RING_SIZE 512     // 8-byte records (power of two)
+#endif
+
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE 32        // Deferred LOG() messages (power of two)
+#endif
+
+// Console output after start-up (log.h)
+#ifndef CONSOLE_DEV
+#ifdef JTAG_UART_NAME
+#define CONSOLE_DEV JTAG_UART_NAME
+#else
+#define CONSOLE_DEV "/dev/jtag_uart"
+#endif
+#endif
+
+#ifndef CONSOLE_LINE_MAX
+#define CONSOLE_LINE_MAX 128    // Bytes per console write; longer lines are cut
+#endif
+
+#ifndef CONSOLE_STALL_US
+#define CONSOLE_STALL_US 1000000    // console_write_all() gives up (no host)
+#endif
+
+// Place the acquisition hot path in on-chip memory (hot.h). Set by the
+// Makefile when HOT_REGION names the memory region.
+#ifndef HOT_MEMORY
+#define HOT_MEMORY 0
+#endif
+
+/* ------------------------- ACCELEROMETER --------------------------- */
+
+#ifndef ACC_SPI_DEV_NAME
+#ifdef ACCELEROMETER_SPI_NAME
+#define ACC_SPI_DEV_NAME ACCELEROMETER_SPI_NAME
+#else
+#define ACC_SPI_DEV_NAME "/dev/accelerometer_spi"
+#endif
+#endif
+
+// Base of a generic Avalon SPI master wired to the G-sensor. When
+// defined, register blocks are read with one multi-byte SPI transaction
+// instead of one University Program core access per register.
+// #define ACC_SPI_BASE ACCELEROMETER_SPI_BASE
+
+#ifndef ACC_SPI_SLAVE
+#define ACC_SPI_SLAVE 0
+#endif
+
+// Edge-capture PIO wired to the ADXL345 INT1 pin. When defined, the
+// FIFO watermark interrupt releases the acquisition task (acc_irq.h)
+// instead of the task polling every ACC_PERIOD_TICKS.
+// #define ACC_INT_PIO_BASE ACC_INT1_PIO_BASE
+// #define ACC_INT_PIO_IRQ ACC_INT1_PIO_IRQ
+// #define ACC_INT_PIO_IRQ_INTERRUPT_CONTROLLER_ID ACC_INT1_PIO_IRQ_INTERRUPT_CONTROLLER_ID
+
+#ifndef ACC_INT_PIO_MASK
+#define ACC_INT_PIO_MASK 0x1    // PIO bit of INT1
+#endif
+
+#ifndef SEM_ACC_DATA
+#define SEM_ACC_DATA 1          // Semaphore the ISR releases
+#endif
+
+// FIFO level that raises the ADXL345 watermark interrupt (INT1)
+#ifndef ACC_FIFO_WATERMARK
+#define ACC_FIFO_WATERMARK 16
+#endif
+
+// ADXL345 output data rate: 100, 200, 400, 800, 1600 or 3200 Hz
+#ifndef ACC_ODR_HZ
+#define ACC_ODR_HZ 100
+#endif
+
+#ifndef ACC_PERIOD_TICKS
+#define ACC_PERIOD_TICKS 1      // Acquisition task period (FIFO drain)
+#endif
+
+#if ACC_FIFO_WATERMARK < 1 || ACC_FIFO_WATERMARK > 31
+#error "ACC_FIFO_WATERMARK must be 1..31"
+#endif
+
+#ifndef SAMPLE_RING_SIZE
+#define SAMPLE_RING_SIZE 1024   // Samples kept for consumers (power of two)
+#endif
+
+#if ACC_ODR_HZ != 100 && ACC_ODR_HZ != 200 && ACC_ODR_HZ != 400 && \
+    ACC_ODR_HZ != 800 && ACC_ODR_HZ != 1600 && ACC_ODR_HZ != 3200
+#error "ACC_ODR_HZ must be one of the ADXL345 rates 100..3200"
+#endif
+
+// The 32-entry hardware FIFO must not overflow between two drains
+#if ACC_ODR_HZ * ACC_PERIOD_TICKS * RTK_TICK_MS >= 32 * 1000
+#error "ACC_PERIOD_TICKS too long for ACC_ODR_HZ (ADXL345 FIFO overflow)"
+#endif
+
+// Refresh the raw-sample panel about once per second (activations of
+// the acquisition task)
+#ifdef ACC_INT_PIO_BASE
+#define ACC_DISPLAY_PERIODS (ACC_ODR_HZ / ACC_FIFO_WATERMARK)
+#else
+#define ACC_DISPLAY_PERIODS (1000 / (RTK_TICK_MS * ACC_PERIOD_TICKS))
+#endif
+
+// Wake the filter and plot tasks from the acquisition task once it has
+// pushed enough new samples for them (FILTER_EVENT_SAMPLES,
+// PLOT_EVENT_SAMPLES), instead of on their own periods
+#ifndef ACC_EVENTS
+#define ACC_EVENTS 0
+#endif
+
+#ifndef SEM_FILTER_DATA
+#define SEM_FILTER_DATA 3       // Released for the filter task
+#endif
+
+#ifndef SEM_PLOT_DATA
+#define SEM_PLOT_DATA 4         // Released for the plotting task
+#endif
+
+/* ---------------------------- FILTER ------------------------------- */
+
+#ifndef FILTER_BLOCK
+#define FILTER_BLOCK 32         // Samples per pipeline block
+#endif
+
+#ifndef FILTER_EVENT_SAMPLES
+#define FILTER_EVENT_SAMPLES FILTER_BLOCK   // New samples per ACC_EVENTS wake-up
+#endif
+
+#ifndef FILTER_INPUT_SHIFT
+#define FILTER_INPUT_SHIFT 5    // 10-bit counts to Q15 with 6 dB headroom
+#endif
+
+#ifndef FILTER_DECIMATION
+#define FILTER_DECIMATION 2     // Output rate = ACC_ODR_HZ / FILTER_DECIMATION
+#endif
+
+// Opcode of the dual 16x16 MAC custom instruction (see mac.h). Leave
+// undefined to use the software kernel.
+// #define MAC_CI_N ALT_CI_MAC_0_N
+
+#ifndef FIR_MAX_TAPS
+#define FIR_MAX_TAPS 32
+#endif
+
+#ifndef MEDIAN_MAX_WINDOW
+#define MEDIAN_MAX_WINDOW 9
+#endif
+
+#ifndef MA_WINDOW_LOG2
+#define MA_WINDOW_LOG2 4        // Moving-average window of 16 samples
+#endif
+
+#ifndef MA_FRAC_BITS
+#define MA_FRAC_BITS 4          // Fractional bits of the filter output
+#endif
+
+// The 32-bit running sum must hold MA_WINDOW full-scale int16 samples
+#if MA_WINDOW_LOG2 < 0 || MA_WINDOW_LOG2 > 16
+#error "MA_WINDOW_LOG2 must be 0..16"
+#endif
+
+/* -------------------------- ANALYTICS ------------------------------ */
+
+// Motion analytics window (analytics.h), run by the filter task
+#ifndef ANALYTICS_WINDOW_LOG2
+#define ANALYTICS_WINDOW_LOG2 7     // 128 samples, 1.28 s at 100 Hz
+#endif
+
+// |a| in counts that counts as a motion event (1.5 g at 256 counts/g)
+#ifndef ANALYTICS_THRESHOLD
+#define ANALYTICS_THRESHOLD 384
+#endif
+
+#ifndef ANALYTICS_HYSTERESIS
+#define ANALYTICS_HYSTERESIS 32     // Drop below threshold - this to re-arm
+#endif
+
+// The per-axis sum must hold a window of int16 samples
+#if ANALYTICS_WINDOW_LOG2 < 0 || ANALYTICS_WINDOW_LOG2 > 16
+#error "ANALYTICS_WINDOW_LOG2 must be 0..16"
+#endif
+
+/* ------------------------- HOST STREAM ----------------------------- */
+
+// Stream every sample to the host as binary frames (host_stream.h)
+#ifndef HOST_STREAM
+#define HOST_STREAM 0
+#endif
+
+#ifndef HOST_STREAM_DEV
+#ifdef JTAG_UART_NAME
+#define HOST_STREAM_DEV JTAG_UART_NAME
+#else
+#define HOST_STREAM_DEV "/dev/jtag_uart"
+#endif
+#endif
+
+#ifndef HOST_STREAM_PERIOD_TICKS
+#define HOST_STREAM_PERIOD_TICKS 5  // 100 ms
+#endif
+
+#ifndef HOST_STREAM_BATCH
+#define HOST_STREAM_BATCH 64    // Frames per write (16 bytes each)
+#endif
+
+/* ---------------------------- VGA ---------------------------------- */
+
+// Base address of the live VGA framebuffer. When left undefined all
+// fills go through write_pixel() (still row-major); when defined the
+// framebuffer is written directly, two pixels per 32-bit store.
+// #define VGA_FB_BASE 0x08000000
+
+#ifndef VGA_FB_STRIDE
+#define VGA_FB_STRIDE 1024      // Bytes per framebuffer row
+#endif
+
+// Render into an off-screen back buffer and copy the changed rows to
+// the live framebuffer from a single present step (fb_present(), run
+// by the render task).
+#ifndef VGA_DOUBLE_BUFFER
+#define VGA_DOUBLE_BUFFER 0
+#endif
+
+// Section for the back buffer (320x240x2 bytes), e.g. ".sdram". The
+// default lets the linker script place it with the rest of .bss.
+// #define VGA_BACK_BUFFER_SECTION ".sdram"
+
+// Base of an Altera University Program pixel buffer DMA controller.
+// When defined, fb_present() waits for vertical blanking through its
+// swap/status registers before copying.
+// #define VGA_PIXEL_DMA_BASE 0x08100000
+
+// Memory-to-memory mSGDMA dispatcher (unaligned transfers enabled)
+// for framebuffer fills and back-buffer copies; needs VGA_FB_BASE
+// #define VGA_MSGDMA_NAME VGA_MSGDMA_CSR_NAME
+
+#ifndef DMA_BATCH
+#define DMA_BATCH 16            // Descriptors per completion interrupt
+#endif
+
+#ifndef DMA_MIN_PIXELS
+#define DMA_MIN_PIXELS 256      // Smaller fills stay on the CPU
+#endif
+
+#ifndef SEM_DMA_DONE
+#define SEM_DMA_DONE 2          // Released by the completion interrupt
+#endif
+
+// Memory-to-stream mSGDMA dispatcher feeding the host link: raw
+// acc_sample_t blocks are streamed from the sample ring
+// #define HOST_MSGDMA_NAME HOST_MSGDMA_CSR_NAME
+
+#ifndef HOST_DMA_BLOCK
+#define HOST_DMA_BLOCK 64       // Samples per host transfer at most
+#endif
+
+#ifndef VGA_CHAR_WIDTH
+#define VGA_CHAR_WIDTH  8       // Text cell of the 8x8 font (gfx_text)
+#endif
+
+#ifndef VGA_CHAR_HEIGHT
+#define VGA_CHAR_HEIGHT 8
+#endif
+
+#ifndef COMPOSITOR_MAX_RECTS
+#define COMPOSITOR_MAX_RECTS 8  // Dirty rectangles tracked per panel
+#endif
+
+/* ---------------------------- RENDER ------------------------------- */
+
+#ifndef RENDER_QUEUE_SIZE
+#define RENDER_QUEUE_SIZE 32    // Draw commands per panel (power of two)
+#endif
+
+#ifndef RENDER_PERIOD_TICKS
+#define RENDER_PERIOD_TICKS 10  // 200 ms at the 20 ms RTK tick
+#endif
+
+/* ---------------------------- PLOT --------------------------------- */
+
+#ifndef STRIP_CHART_MAX_WIDTH
+#define STRIP_CHART_MAX_WIDTH 150   // Columns of history per strip chart
+#endif
+
+#ifndef PLOT_PERIOD_TICKS
+#define PLOT_PERIOD_TICKS 5     // One new column every 100 ms
+#endif
+
+// With ACC_EVENTS: one column per this many samples (same rate)
+#ifndef PLOT_EVENT_SAMPLES
+#define PLOT_EVENT_SAMPLES (ACC_ODR_HZ * PLOT_PERIOD_TICKS * RTK_TICK_MS / 1000)
+#endif
+
+#if FILTER_EVENT_SAMPLES < 1 || PLOT_EVENT_SAMPLES < 1 || \
+    FILTER_EVENT_SAMPLES >= SAMPLE_RING_SIZE || PLOT_EVENT_SAMPLES >= SAMPLE_RING_SIZE
+#error "FILTER_EVENT_SAMPLES and PLOT_EVENT_SAMPLES must be 1..SAMPLE_RING_SIZE-1"
+#endif
+
+#ifndef PLOT_SCALE_SHIFT
+#define PLOT_SCALE_SHIFT 3      // Raw counts per pixel = 1 << PLOT_SCALE_SHIFT
+#endif
+
+/* --------------------------- SPECTRUM ------------------------------ */
+
+// Show the spectrum of one axis on the plot panel instead of the strip
+// chart; the FFT runs in its own low-priority task (spectrum.h)
+#ifndef SPECTRUM
+#define SPECTRUM 0
+#endif
+
+#ifndef SPECTRUM_FFT_LOG2
+#define SPECTRUM_FFT_LOG2 8     // 256 points (6..9: 64..512)
+#endif
+
+#ifndef SPECTRUM_AXIS
+#define SPECTRUM_AXIS AXIS_Z
+#endif
+
+#ifndef SPECTRUM_INPUT_SHIFT
+#define SPECTRUM_INPUT_SHIFT 4  // Counts to FFT input (clamped to half scale)
+#endif
+
+#ifndef SPECTRUM_BARS
+#define SPECTRUM_BARS 64        // Bars across 150 columns (power of two)
+#endif
+
+// Bin magnitudes up to this are treated as noise and give no bar; the
+// log scale starts above it
+#ifndef SPECTRUM_NOISE_FLOOR
+#define SPECTRUM_NOISE_FLOOR 4
+#endif
+
+#ifndef SPECTRUM_BARS_PER_JOB
+#define SPECTRUM_BARS_PER_JOB 16    // Bars the plot task redraws per job
+#endif
+
+// One FFT per block of new samples
+#ifndef SPECTRUM_PERIOD_TICKS
+#define SPECTRUM_PERIOD_TICKS ((1 << SPECTRUM_FFT_LOG2) * 1000 / (ACC_ODR_HZ * RTK_TICK_MS))
+#endif
+
+#if SPECTRUM_FFT_LOG2 < 6 || SPECTRUM_FFT_LOG2 > 9 || \
+    (1 << SPECTRUM_FFT_LOG2) > SAMPLE_RING_SIZE / 2
+#error "SPECTRUM_FFT_LOG2 must be 6..9 and leave half the sample ring"
+#endif
+
+#if SPECTRUM_BARS < 1 || SPECTRUM_BARS > 128 || (SPECTRUM_BARS & (SPECTRUM_BARS - 1)) || \
+    SPECTRUM_BARS > (1 << SPECTRUM_FFT_LOG2) / 2
+#error "SPECTRUM_BARS must be a power of two, at most 128 and at most half the FFT points"
+#endif
+
+#if SPECTRUM_BARS_PER_JOB < 1 || SPECTRUM_BARS_PER_JOB >= RENDER_QUEUE_SIZE
+#error "SPECTRUM_BARS_PER_JOB must be 1..RENDER_QUEUE_SIZE-1"
+#endif
+
+// Rate-monotonic priorities: a longer period keeps the FFT task
+// below the acquisition task
+#if SPECTRUM && SPECTRUM_PERIOD_TICKS <= ACC_PERIOD_TICKS
+#error "SPECTRUM_PERIOD_TICKS must be longer than ACC_PERIOD_TICKS"
+#endif
+
+/* -------------------------- BENCHMARK ------------------------------ */
+
+// Benchmark build (bench.h): set by ACTIVE_BUILD_CONFIG=bench
+#ifndef BENCH
+#define BENCH 0
+#endif
+
+#ifndef BENCH_ITERATIONS
+#define BENCH_ITERATIONS 64     // Calls per timed run
+#endif
+
+#ifndef BENCH_REPEATS
+#define BENCH_REPEATS 5         // Runs per benchmark, fastest kept
+#endif
+
+#ifndef BENCH_PERIODS
+#define BENCH_PERIODS 50        // Timed wait_for_next_period() calls
+#endif
+
+#ifndef BENCH_STACK_SIZE
+#define BENCH_STACK_SIZE 1024   // Prints the table
+#endif
+
+#endif /* APP_CONFIG_H_ */
@@ -0,0 +1,11 @@
+#ifndef BARRIER_H_
+#define BARRIER_H_
+
+/*
+ * The Nios II core is single-issue and in-order with one bus master per
+ * task, so lock-free structures shared between tasks (and ISRs) only
+ * need the compiler to keep stores in program order.
+ */
+#define compiler_barrier() __asm__ __volatile__("" ::: "memory")
+
+#endif /* BARRIER_H_ */
@@ -0,0 +1,373 @@
+#include <stdio.h>
+#include "altera_avalon_sierra_ker.h"
+#include <sys/alt_timestamp.h>
+#include "system.h"
+#include <DE10_Lite_VGA_Driver.h>
+#include "acc_filter.h"
+#include "analytics.h"
+#include "bench.h"
+#include "fft.h"
+#include "filter_pipeline.h"
+#include "gfx.h"
+#include "idle.h"
+#include "mac.h"
+#include "moving_average.h"
+#include "mutex.h"
+#include "sample_ring.h"
+#include "tasks.h"
+#include "vga_fb.h"
+
+#if BENCH
+
+#define BENCH_TASK_ID   1
+#define BENCH_PRIORITY  1
+#define BENCH_SEM       SEM_ACC_DATA    // Nothing else runs to take it
+
+static char idle_stack[IDLE_STACK_SIZE];
+static char bench_stack[BENCH_STACK_SIZE];
+
+typedef struct bench {
+    const char *name;
+    void (*setup)(size_t arg);          // Untimed, may be NULL
+    void (*run)(size_t arg);            // One operation
+    size_t arg;
+    size_t items;                       // Pixels, characters or samples
+} bench_t;
+
+/* ================================================================
+ *                          OPERATIONS
+ * ================================================================ */
+static q15_t input[FIR_MAX_TAPS - 1 + FILTER_BLOCK];
+static q15_t output[FILTER_BLOCK];
+static q15_t coeffs[FIR_MAX_TAPS];
+static alt_16 raw[AXIS_COUNT][FILTER_BLOCK] __attribute__((aligned(4)));
+static alt_16 filtered[AXIS_COUNT][FILTER_BLOCK];
+static fir_t fir;
+static median_t median;
+static biquad_t biquad;
+static moving_average_t average;
+static ma_xyz_t average_xyz;
+static complex_q15_t spectrum[FFT_MAX_POINTS];
+static gfx_field_t field;
+static mutex_t mutex;
+static volatile alt_32 sink;            // Keeps results alive
+static size_t counter;
+
+static void run_empty(size_t arg)
+{
+}
+
+static void run_write_pixel(size_t arg)
+{
+    write_pixel(counter++ & 0xFF, 200, Col_White);
+}
+
+static void run_fb_pixel(size_t arg)
+{
+    fb_pixel(counter++ & 0xFF, 200, Col_White);
+}
+
+// arg x arg square; 110 is about the panel area the original
+// clear_screen_range() calls cleared
+static void run_fb_fill_rect(size_t arg)
+{
+    fb_fill_rect(170, 0, 170 + arg - 1, arg - 1, Col_Black);
+}
+
+static void run_fb_present(size_t arg)
+{
+    fb_fill_rect(0, 200, arg - 1, 207, Col_Blue);
+    fb_present();
+}
+
+static void run_tty_print(size_t arg)
+{
+    tty_print(0, 210, "0123456789", Col_White, Col_Black);
+}
+
+static void run_gfx_text(size_t arg)
+{
+    gfx_text(0, 220, "0123456789", Col_White, Col_Black);
+}
+
+static void run_int_print(size_t arg)
+{
+    int_print(100, 210, (int)counter++, arg, Col_White, Col_Black);
+}
+
+static void run_gfx_int(size_t arg)
+{
+    gfx_int(100, 220, (int)counter++, arg, Col_White, Col_Black);
+}
+
+static void setup_field(size_t arg)
+{
+    gfx_field_init(&field, 200, 220, arg, Col_White, Col_Black);
+}
+
+static void run_gfx_field_draw(size_t arg)
+{
+    gfx_field_draw(&field, (int)counter++);
+}
+
+static void run_draw_filled_circle(size_t arg)
+{
+    draw_filled_circle(280, 200, arg, Col_Green);
+}
+
+// Untraced on purpose: this entry measures the kernel calls alone
+static void run_sem_pair(size_t arg)
+{
+    sem_take(BENCH_SEM);
+    sem_release(BENCH_SEM);
+}
+
+static void run_mutex_pair(size_t arg)
+{
+    mutex_lock(&mutex);
+    mutex_unlock(&mutex);
+}
+
+static void setup_input(size_t arg)
+{
+    for (size_t i = 0; i < sizeof(input) / sizeof(input[0]); i++)
+        input[i] = (q15_t)((alt_u32)i * 2654435761u >> 16);    // Scrambled, signed
+    for (size_t i = 0; i < FIR_MAX_TAPS; i++)
+        coeffs[i] = (q15_t)(32768 / FIR_MAX_TAPS);
+    for (size_t i = 0; i < FILTER_BLOCK; i++)
+        for (size_t a = 0; a < AXIS_COUNT; a++)
+            raw[a][i] = input[i + a] >> 8;
+}
+
+static void run_mac_dot_q15(size_t arg)
+{
+    sink = mac_dot_q15(input, coeffs, arg);
+}
+
+static void setup_fir(size_t arg)
+{
+    setup_input(arg);
+    fir_init(&fir, coeffs, arg);
+}
+
+static void run_fir_process(size_t arg)
+{
+    fir_process(&fir, input, output, FILTER_BLOCK);
+}
+
+static void setup_median(size_t arg)
+{
+    setup_input(arg);
+    median_init(&median, arg);
+}
+
+static void run_median_process(size_t arg)
+{
+    median_process(&median, input, output, FILTER_BLOCK);
+}
+
+static void setup_biquad(size_t arg)
+{
+    setup_input(arg);
+    biquad_init(&biquad, 329, 658, 329, -25576, 10508);
+}
+
+static void run_biquad_process(size_t arg)
+{
+    biquad_process(&biquad, input, output, FILTER_BLOCK);
+}
+
+static void setup_average(size_t arg)
+{
+    setup_input(arg);
+    ma_init(&average);
+}
+
+static void run_ma_push(size_t arg)
+{
+    sink = ma_push(&average, input[counter++ % FILTER_BLOCK]);
+}
+
+static void setup_avg_xyz(size_t arg)
+{
+    setup_input(arg);
+    ma_xyz_init(&average_xyz);
+}
+
+static void run_ma_xyz_block(size_t arg)
+{
+    ma_xyz_push_block(&average_xyz, raw[AXIS_X], raw[AXIS_Y], raw[AXIS_Z], FILTER_BLOCK);
+}
+
+static void setup_acc_filter(size_t arg)
+{
+    setup_input(arg);
+    acc_filter_init();
+}
+
+static void setup_analytics(size_t arg)
+{
+    setup_input(arg);
+    analytics_init();
+}
+
+static void run_analytics(size_t arg)
+{
+    analytics_process(raw, FILTER_BLOCK);
+}
+
+static void run_acc_filter(size_t arg)
+{
+    sink = acc_filter_process(raw, FILTER_BLOCK, filtered);
+}
+
+// The transform costs the same for any data, so later runs may work
+// on the output of earlier ones
+static void setup_fft(size_t arg)
+{
+    setup_input(arg);
+    for (size_t i = 0; i < FFT_MAX_POINTS; i++)
+    {
+        spectrum[i].re = input[i % FILTER_BLOCK] >> 1;
+        spectrum[i].im = 0;
+    }
+}
+
+static void run_fft(size_t arg)
+{
+    fft_q15(spectrum, arg);
+}
+
+static const bench_t benches[] = {
+    { "write_pixel",          NULL,             run_write_pixel,         1,   1 },
+    { "fb_pixel",             NULL,             run_fb_pixel,            1,   1 },
+    { "fb_fill_rect",         NULL,             run_fb_fill_rect,        8,   8 * 8 },
+    { "fb_fill_rect",         NULL,             run_fb_fill_rect,      110, 110 * 110 },
+    { "fb_present",           NULL,             run_fb_present,         64,  64 * 8 },
+    { "tty_print",            NULL,             run_tty_print,           0,  10 },
+    { "gfx_text",             NULL,             run_gfx_text,            0,  10 },
+    { "int_print",            NULL,             run_int_print,           5,   5 },
+    { "gfx_int",              NULL,             run_gfx_int,             5,   5 },
+    { "gfx_field_draw",       setup_field,      run_gfx_field_draw,      5,   5 },
+    { "draw_filled_circle",   NULL,             run_draw_filled_circle,  5,   1 },
+    { "draw_filled_circle",   NULL,             run_draw_filled_circle, 20,   1 },
+    { "sem_take+release",     NULL,             run_sem_pair,            0,   1 },
+    { "mutex_lock+unlock",    NULL,             run_mutex_pair,          0,   1 },
+    { "mac_dot_q15",          setup_input,      run_mac_dot_q15,         8,   8 },
+    { "mac_dot_q15",          setup_input,      run_mac_dot_q15,        16,  16 },
+    { "mac_dot_q15",          setup_input,      run_mac_dot_q15,        32,  32 },
+    { "fir_process",          setup_fir,        run_fir_process,         7, FILTER_BLOCK },
+    { "fir_process",          setup_fir,        run_fir_process,        15, FILTER_BLOCK },
+    { "fir_process",          setup_fir,        run_fir_process,        31, FILTER_BLOCK },
+    { "median_process",       setup_median,     run_median_process,      3, FILTER_BLOCK },
+    { "median_process",       setup_median,     run_median_process,      5, FILTER_BLOCK },
+    { "median_process",       setup_median,     run_median_process,      9, FILTER_BLOCK },
+    { "biquad_process",       setup_biquad,     run_biquad_process,      0, FILTER_BLOCK },
+    { "ma_push",              setup_average,    run_ma_push,             0,   1 },
+    { "ma_xyz_push_block",    setup_avg_xyz,    run_ma_xyz_block,        0, FILTER_BLOCK },
+    { "acc_filter_process",   setup_acc_filter, run_acc_filter,          0, FILTER_BLOCK },
+    { "analytics_process",    setup_analytics,  run_analytics,           0, FILTER_BLOCK },
+    { "fft_q15",              setup_fft,        run_fft,                 6,  64 },
+    { "fft_q15",              setup_fft,        run_fft,                 9, 512 },
+};
+
+/* ================================================================
+ *                          MEASUREMENT
+ * ================================================================ */
+static alt_u64 cpu_per_tick_q16;        // CPU cycles per timestamp tick (Q16)
+
+// Fastest of BENCH_REPEATS runs, in timestamp ticks
+static __attribute__((noinline)) alt_u32 time_bench(const bench_t *b)
+{
+    alt_u32 best = 0xFFFFFFFF;
+
+    for (size_t r = 0; r < BENCH_REPEATS; r++)
+    {
+        alt_u32 start = alt_timestamp();
+
+        for (size_t i = 0; i < BENCH_ITERATIONS; i++)
+            b->run(b->arg);
+
+        alt_u32 elapsed = alt_timestamp() - start;
+        if (elapsed < best)
+            best = elapsed;
+    }
+
+    return best;
+}
+
+static alt_u32 to_cycles(alt_u32 ticks, size_t per)
+{
+    return (alt_u32)(((alt_u64)ticks * cpu_per_tick_q16 / per) >> 16);
+}
+
+static void report_periods(void)
+{
+    alt_u32 nominal = alt_timestamp_freq() / 1000 * RTK_TICK_MS;
+    alt_u32 min = 0xFFFFFFFF, max = 0;
+    alt_u32 last;
+
+    init_period_time(1);
+    wait_for_next_period();             // Start on a tick boundary
+    last = alt_timestamp();
+
+    for (size_t i = 0; i < BENCH_PERIODS; i++)
+    {
+        wait_for_next_period();
+
+        alt_u32 now = alt_timestamp();
+        alt_u32 interval = now - last;
+        last = now;
+
+        if (interval < min) min = interval;
+        if (interval > max) max = interval;
+    }
+
+    printf("wait_for_next_period: tick %lu cycles, interval %lu..%lu (jitter %lu)\n",
+           (unsigned long)to_cycles(nominal, 1),
+           (unsigned long)to_cycles(min, 1), (unsigned long)to_cycles(max, 1),
+           (unsigned long)to_cycles(max - min, 1));
+}
+
+static void bench_code(void)
+{
+    const bench_t empty = { "empty", NULL, run_empty, 0, 1 };
+    alt_u32 overhead;
+
+    cpu_per_tick_q16 = ((alt_u64)ALT_CPU_FREQ << 16) / alt_timestamp_freq();
+    overhead = time_bench(&empty);
+
+    printf("\n%lu iterations, best of %u, %lu cycles call overhead removed\n",
+           (unsigned long)BENCH_ITERATIONS, (unsigned)BENCH_REPEATS,
+           (unsigned long)to_cycles(overhead, BENCH_ITERATIONS));
+    printf("%-20s %5s %10s %10s\n", "operation", "arg", "cycles/op", "per item");
+
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++)
+    {
+        const bench_t *b = &benches[i];
+
+        if (b->setup)
+            b->setup(b->arg);
+
+        alt_u32 ticks = time_bench(b);
+        ticks = ticks > overhead ? ticks - overhead : 0;
+
+        alt_u32 per_op = to_cycles(ticks, BENCH_ITERATIONS);
+        printf("%-20s %5lu %10lu %10lu\n", b->name, (unsigned long)b->arg,
+               (unsigned long)per_op, (unsigned long)(per_op / b->items));
+    }
+
+    report_periods();
+    printf("Benchmarks done\n");
+
+    while (1)
+        wait_for_next_period();
+}
+
+void bench_create(void)
+{
+    task_create(TASK_IDLE, 0, READY_TASK_STATE, idle_code, idle_stack, sizeof(idle_stack));
+    task_create(BENCH_TASK_ID, BENCH_PRIORITY, READY_TASK_STATE, bench_code, bench_stack, sizeof(bench_stack));
+}
+
+#endif /* BENCH */
@@ -0,0 +1,31 @@
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  MICRO-BENCHMARKS
+ * ---------------------------------------------------------------------
+ *  Built with BENCH=1 (ACTIVE_BUILD_CONFIG=bench, or bench_debug at
+ *  -O0). main() then creates the benchmark task and the idle task
+ *  instead of the task table. The task times every drawing primitive,
+ *  filter kernel and kernel call with alt_timestamp() and prints one
+ *  table of CPU cycles per operation to the console.
+ *
+ *  Every benchmark runs BENCH_ITERATIONS back-to-back calls, repeated
+ *  BENCH_REPEATS times. The fastest repeat is kept, so an RTK tick that
+ *  landed inside a run does not count, and the cost of an empty call
+ *  is subtracted. "per item" divides the result by the pixels,
+ *  characters or samples one call handles.
+ * ---------------------------------------------------------------------
+ */
+
+#if BENCH
+
+// Create the benchmark and idle tasks (before tsw_on())
+void bench_create(void);
+
+#endif
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,156 @@
+#include <string.h>
+#include <stdbool.h>
+#include <DE10_Lite_VGA_Driver.h>
+#include "app_config.h"
+#include "compositor.h"
+#include "gfx.h"
+
+typedef struct panel {
+    rect_t bounds;                          // Screen area owned by the panel
+    vga_color_t background;
+    rect_t dirty[COMPOSITOR_MAX_RECTS];
+    size_t dirty_count;
+} panel_t;
+
+// Screen layout (axes are drawn at x = 160 and y = 120)
+static panel_t panels[PANEL_COUNT] = {
+    [PANEL_ACC]    = { {   0,   0, 159, 119 }, Col_Black, {{0}}, 0 },
+    [PANEL_FILTER] = { { 161,   0, 319, 119 }, Col_Black, {{0}}, 0 },
+    [PANEL_TIMER]  = { {   0, 121, 159, 239 }, Col_Black, {{0}}, 0 },
+    [PANEL_PLOT]   = { { 161, 121, 319, 239 }, Col_Black, {{0}}, 0 },
+};
+
+/* ================================================================
+ *                      RECTANGLE HELPERS
+ * ================================================================ */
+static size_t rect_area(const rect_t *r)
+{
+    return (size_t)(r->x1 - r->x0 + 1) * (size_t)(r->y1 - r->y0 + 1);
+}
+
+static rect_t rect_union(const rect_t *a, const rect_t *b)
+{
+    rect_t u;
+    u.x0 = a->x0 < b->x0 ? a->x0 : b->x0;
+    u.y0 = a->y0 < b->y0 ? a->y0 : b->y0;
+    u.x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+    u.y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+    return u;
+}
+
+static bool rect_touches(const rect_t *a, const rect_t *b)
+{
+    return a->x0 <= b->x1 + 1 && b->x0 <= a->x1 + 1 &&
+           a->y0 <= b->y1 + 1 && b->y0 <= a->y1 + 1;
+}
+
+/* ================================================================
+ *                      COMPOSITOR API
+ * ================================================================ */
+void compositor_init(void)
+{
+    for (size_t i = 0; i < PANEL_COUNT; i++)
+        panels[i].dirty_count = 0;
+}
+
+void compositor_mark_dirty(panel_id_t panel, size_t x0, size_t y0, size_t x1, size_t y1)
+{
+    panel_t *p = &panels[panel];
+    rect_t r;
+
+    // Clip to the panel so one task can never erase another's area
+    if (x0 < p->bounds.x0) x0 = p->bounds.x0;
+    if (y0 < p->bounds.y0) y0 = p->bounds.y0;
+    if (x1 > p->bounds.x1) x1 = p->bounds.x1;
+    if (y1 > p->bounds.y1) y1 = p->bounds.y1;
+
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    r.x0 = x0;
+    r.y0 = y0;
+    r.x1 = x1;
+    r.y1 = y1;
+
+    // Grow an overlapping or adjacent rectangle when possible
+    for (size_t i = 0; i < p->dirty_count; i++)
+    {
+        if (rect_touches(&p->dirty[i], &r))
+        {
+            p->dirty[i] = rect_union(&p->dirty[i], &r);
+            return;
+        }
+    }
+
+    if (p->dirty_count < COMPOSITOR_MAX_RECTS)
+    {
+        p->dirty[p->dirty_count++] = r;
+        return;
+    }
+
+    // List is full: merge into the rectangle that grows the least
+    size_t best = 0;
+    size_t best_growth = (size_t)-1;
+
+    for (size_t i = 0; i < p->dirty_count; i++)
+    {
+        rect_t u = rect_union(&p->dirty[i], &r);
+        size_t growth = rect_area(&u) - rect_area(&p->dirty[i]);
+
+        if (growth < best_growth)
+        {
+            best_growth = growth;
+            best = i;
+        }
+    }
+
+    p->dirty[best] = rect_union(&p->dirty[best], &r);
+}
+
+void compositor_flush(panel_id_t panel)
+{
+    panel_t *p = &panels[panel];
+
+    for (size_t i = 0; i < p->dirty_count; i++)
+    {
+        const rect_t *r = &p->dirty[i];
+        fb_fill_rect(r->x0, r->y0, r->x1, r->y1, p->background);
+    }
+
+    p->dirty_count = 0;
+}
+
+/* ================================================================
+ *                      TRACKED DRAWING
+ * ================================================================ */
+void comp_text(panel_id_t panel, size_t x, size_t y, const char *text, vga_color_t fg, vga_color_t bg)
+{
+    size_t len = strlen(text);
+
+    gfx_text(x, y, text, fg, bg);
+
+    if (len > 0)
+        compositor_mark_dirty(panel, x, y,
+                              x + len * VGA_CHAR_WIDTH - 1,
+                              y + VGA_CHAR_HEIGHT - 1);
+}
+
+void comp_int(panel_id_t panel, size_t x, size_t y, int value, size_t digits, vga_color_t fg, vga_color_t bg)
+{
+    gfx_int(x, y, value, digits, fg, bg);
+
+    // One extra cell for a possible minus sign
+    compositor_mark_dirty(panel, x, y,
+                          x + (digits + 1) * VGA_CHAR_WIDTH - 1,
+                          y + VGA_CHAR_HEIGHT - 1);
+}
+
+void comp_circle(panel_id_t panel, size_t x, size_t y, size_t radius, vga_color_t color)
+{
+    gfx_circle(x, y, radius, color);
+
+    compositor_mark_dirty(panel,
+                          x > radius ? x - radius : 0,
+                          y > radius ? y - radius : 0,
+                          x + radius, y + radius);
+}
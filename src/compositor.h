@@ -0,0 +1,48 @@
+#ifndef COMPOSITOR_H_
+#define COMPOSITOR_H_
+
+#include <stddef.h>
+#include "vga_fb.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  DIRTY-RECTANGLE COMPOSITOR
+ * ---------------------------------------------------------------------
+ *  The screen is split into one panel per task. Every draw made through
+ *  the comp_* helpers records the rectangle it touched in its panel;
+ *  compositor_flush() later erases exactly those rectangles instead of
+ *  the whole panel. Only the render task calls into the compositor once
+ *  the tasks are running, so no locking is needed.
+ * ---------------------------------------------------------------------
+ */
+
+typedef enum {
+    PANEL_ACC = 0,      // Top-left:     raw samples
+    PANEL_FILTER,       // Top-right:    filtered samples
+    PANEL_TIMER,        // Bottom-left:  running time
+    PANEL_PLOT,         // Bottom-right: Z-axis graph
+    PANEL_COUNT
+} panel_id_t;
+
+// Inclusive rectangle
+typedef struct rect {
+    alt_u16 x0;
+    alt_u16 y0;
+    alt_u16 x1;
+    alt_u16 y1;
+} rect_t;
+
+void compositor_init(void);
+
+// Record an area of a panel that has to be erased on the next flush
+void compositor_mark_dirty(panel_id_t panel, size_t x0, size_t y0, size_t x1, size_t y1);
+
+// Erase every dirty rectangle of a panel with its background colour
+void compositor_flush(panel_id_t panel);
+
+// Draw helpers that also record what they touched
+void comp_text(panel_id_t panel, size_t x, size_t y, const char *text, vga_color_t fg, vga_color_t bg);
+void comp_int(panel_id_t panel, size_t x, size_t y, int value, size_t digits, vga_color_t fg, vga_color_t bg);
+void comp_circle(panel_id_t panel, size_t x, size_t y, size_t radius, vga_color_t color);
+
+#endif /* COMPOSITOR_H_ */
@@ -0,0 +1,165 @@
+#include <stdint.h>
+#include "altera_avalon_sierra_ker.h"
+#include <altera_msgdma.h>
+#include <sys/alt_cache.h>
+#include "dma.h"
+#include "sample_ring.h"
+#include "trace.h"
+
+#define DESC_IRQ ALTERA_MSGDMA_DESCRIPTOR_CONTROL_TRANSFER_COMPLETE_IRQ_MASK
+
+#ifdef VGA_MSGDMA_NAME
+
+static alt_msgdma_dev *vga_dma;
+static volatile bool vga_busy;          // A batch is in flight
+static size_t vga_queued;               // Descriptors in the current batch
+
+static void vga_done(void *context)
+{
+    (void)context;
+
+    vga_busy = false;
+    trace_sem_release(TRACE_TASK_ISR, SEM_DMA_DONE);
+}
+
+bool dma_vga_open(void)
+{
+    vga_dma = alt_msgdma_open(VGA_MSGDMA_NAME);
+    if (!vga_dma)
+        return false;
+
+    alt_msgdma_register_callback(vga_dma, vga_done, ALTERA_MSGDMA_CSR_GLOBAL_INTERRUPT_MASK, NULL);
+    return true;
+}
+
+/* ================================================================
+ *                  BATCHED MEMORY-TO-MEMORY COPY
+ *  Only the last descriptor of a batch raises the completion
+ *  interrupt. A batch is closed by re-queuing its last copy with the
+ *  IRQ bit, so descriptors are held back by one.
+ * ================================================================ */
+static alt_msgdma_standard_descriptor held;
+static bool holding;
+
+static void submit(alt_msgdma_standard_descriptor *desc)
+{
+    // The dispatcher FIFO is sized for DMA_BATCH, so this only spins
+    // if the hardware was built with a smaller one
+    while (alt_msgdma_standard_descriptor_async_transfer(vga_dma, desc) != 0);
+}
+
+static void wait_batch(void)
+{
+    // Re-checked after every wake-up: the semaphore may carry a stale
+    // release from before the batch started
+    while (vga_busy)
+        trace_sem_take(TRACE_TASK_UNKNOWN, SEM_DMA_DONE);
+}
+
+static void close_batch(void)
+{
+    if (!holding)
+        return;
+
+    held.control |= DESC_IRQ;
+    vga_busy = true;
+    submit(&held);
+    holding = false;
+    vga_queued = 0;
+
+    wait_batch();
+}
+
+void dma_vga_copy(alt_u32 dst, const void *src, size_t bytes)
+{
+    if (bytes == 0)
+        return;
+
+    alt_dcache_flush((void *)src, bytes);
+
+    if (holding)
+        submit(&held);
+
+    alt_msgdma_construct_standard_mm_to_mm_descriptor(vga_dma, &held,
+                                                      (alt_u32 *)src, (alt_u32 *)(uintptr_t)dst,
+                                                      bytes, 0);
+    holding = true;
+
+    if (++vga_queued >= DMA_BATCH)
+        close_batch();
+}
+
+void dma_vga_sync(void)
+{
+    close_batch();
+}
+
+#endif /* VGA_MSGDMA_NAME */
+
+#ifdef HOST_MSGDMA_NAME
+
+static alt_msgdma_dev *host_dma;
+static volatile bool host_busy;
+static sample_cursor_t host_cursor;
+static size_t host_pending;             // Samples in the block in flight
+
+static void host_done(void *context)
+{
+    (void)context;
+    host_busy = false;
+}
+
+bool dma_host_open(void)
+{
+    host_dma = alt_msgdma_open(HOST_MSGDMA_NAME);
+    if (!host_dma)
+        return false;
+
+    alt_msgdma_register_callback(host_dma, host_done, ALTERA_MSGDMA_CSR_GLOBAL_INTERRUPT_MASK, NULL);
+    sample_cursor_init(&acc_ring, &host_cursor);
+    return true;
+}
+
+/* ================================================================
+ *                  ZERO-COPY SAMPLE STREAM
+ *  The DMA reads the block straight out of acc_ring. The cursor is
+ *  only advanced once the block has left, and the ring holds far more
+ *  than one block, so the producer does not reach it in time.
+ * ================================================================ */
+void dma_host_poll(void)
+{
+    alt_msgdma_standard_descriptor desc;
+    const acc_sample_t *span;
+    size_t count;
+
+    if (host_busy)
+        return;
+
+    sample_ring_consume(&host_cursor, host_pending);
+    host_pending = 0;
+
+    count = sample_ring_peek(&acc_ring, &host_cursor, &span, HOST_DMA_BLOCK);
+    if (count == 0)
+        return;
+
+    alt_dcache_flush((void *)span, count * sizeof(*span));
+
+    alt_msgdma_construct_standard_mm_to_st_descriptor(host_dma, &desc, (alt_u32 *)span,
+                                                      count * sizeof(*span), DESC_IRQ);
+    host_busy = true;
+
+    if (alt_msgdma_standard_descriptor_async_transfer(host_dma, &desc) != 0)
+    {
+        host_busy = false;      // Dispatcher full: retry on the next poll
+        return;
+    }
+
+    host_pending = count;
+}
+
+alt_u32 dma_host_lost(void)
+{
+    return host_cursor.lost;
+}
+
+#endif /* HOST_MSGDMA_NAME */
@@ -0,0 +1,57 @@
+#ifndef DMA_H_
+#define DMA_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <alt_types.h>
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  mSGDMA TRANSFERS
+ * ---------------------------------------------------------------------
+ *  Two optional dispatchers:
+ *
+ *   VGA_MSGDMA_NAME   memory-to-memory, used by vga_fb for large fills
+ *                     and for copying the back buffer to the screen.
+ *                     The caller queues descriptors and sleeps on
+ *                     SEM_DMA_DONE until the completion interrupt, so
+ *                     other tasks get the CPU while pixels move. Only
+ *                     the render task may use it.
+ *
+ *   HOST_MSGDMA_NAME  memory-to-stream, feeding the host link. Raw
+ *                     sample blocks are sent straight out of the sample
+ *                     ring (no copy); the idle task starts a block
+ *                     whenever the previous one has completed.
+ *
+ *  Source buffers are flushed from the data cache before each transfer.
+ * ---------------------------------------------------------------------
+ */
+
+#ifdef VGA_MSGDMA_NAME
+
+bool dma_vga_open(void);
+
+// Queue a copy of bytes from src to the bus address dst. Every
+// DMA_BATCH copies the caller waits for the batch to complete.
+void dma_vga_copy(alt_u32 dst, const void *src, size_t bytes);
+
+// Wait until every queued copy has completed
+void dma_vga_sync(void);
+
+#endif /* VGA_MSGDMA_NAME */
+
+#ifdef HOST_MSGDMA_NAME
+
+bool dma_host_open(void);
+
+// Start streaming the samples produced since the last call, if the
+// previous block has completed (idle task)
+void dma_host_poll(void);
+
+// Samples lost because the stream fell a whole ring behind
+alt_u32 dma_host_lost(void);
+
+#endif /* HOST_MSGDMA_NAME */
+
+#endif /* DMA_H_ */
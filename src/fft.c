@@ -0,0 +1,122 @@
+#include "fft.h"
+
+#define QUARTER (FFT_MAX_POINTS / 4)
+
+// sin(2 pi k / FFT_MAX_POINTS) in Q15 for k = 0..FFT_MAX_POINTS / 4
+static const q15_t sine_table[QUARTER + 1] = {
+        0,   402,   804,  1206,  1608,  2009,  2410,  2811,  3212,  3612,
+     4011,  4410,  4808,  5205,  5602,  5998,  6393,  6786,  7179,  7571,
+     7962,  8351,  8739,  9126,  9512,  9896, 10278, 10659, 11039, 11417,
+    11793, 12167, 12539, 12910, 13279, 13645, 14010, 14372, 14732, 15090,
+    15446, 15800, 16151, 16499, 16846, 17189, 17530, 17869, 18204, 18537,
+    18868, 19195, 19519, 19841, 20159, 20475, 20787, 21096, 21403, 21705,
+    22005, 22301, 22594, 22884, 23170, 23452, 23731, 24007, 24279, 24547,
+    24811, 25072, 25329, 25582, 25832, 26077, 26319, 26556, 26790, 27019,
+    27245, 27466, 27683, 27896, 28105, 28310, 28510, 28706, 28898, 29085,
+    29268, 29447, 29621, 29791, 29956, 30117, 30273, 30424, 30571, 30714,
+    30852, 30985, 31113, 31237, 31356, 31470, 31580, 31685, 31785, 31880,
+    31971, 32057, 32137, 32213, 32285, 32351, 32412, 32469, 32521, 32567,
+    32609, 32646, 32678, 32705, 32728, 32745, 32757, 32765, 32767
+};
+
+// sin and cos of the angle 2 pi k / FFT_MAX_POINTS, from the quarter wave
+static alt_32 sine(size_t k)
+{
+    size_t r = k % QUARTER;
+
+    switch ((k / QUARTER) & 3)
+    {
+    case 0:  return sine_table[r];
+    case 1:  return sine_table[QUARTER - r];
+    case 2:  return -sine_table[r];
+    default: return -sine_table[QUARTER - r];
+    }
+}
+
+static alt_32 cosine(size_t k)
+{
+    return sine(k + QUARTER);
+}
+
+/* ================================================================
+ *                          TRANSFORM
+ *  Bit-reversed reordering, then log2n stages of butterflies. In the
+ *  stage with groups of 2 * half points the twiddle of butterfly k is
+ *  W = exp(-2 pi i k / (2 * half)), index k * stride in the table.
+ * ================================================================ */
+static void bit_reverse(complex_q15_t *x, size_t n)
+{
+    for (size_t i = 1, j = 0; i < n; i++)
+    {
+        size_t bit = n >> 1;
+
+        for (; j & bit; bit >>= 1)
+            j ^= bit;
+        j |= bit;
+
+        if (i < j)
+        {
+            complex_q15_t swap = x[i];
+            x[i] = x[j];
+            x[j] = swap;
+        }
+    }
+}
+
+void fft_q15(complex_q15_t *x, unsigned log2n)
+{
+    const size_t n = (size_t)1 << log2n;
+
+    bit_reverse(x, n);
+
+    for (size_t half = 1, stride = FFT_MAX_POINTS / 2; half < n; half <<= 1, stride >>= 1)
+    {
+        for (size_t k = 0; k < half; k++)
+        {
+            const alt_32 wr = cosine(k * stride);
+            const alt_32 wi = sine(k * stride);
+
+            for (size_t i = k; i < n; i += 2 * half)
+            {
+                complex_q15_t *u = &x[i];
+                complex_q15_t *v = &x[i + half];
+
+                // t = W * v with W = wr - i wi
+                alt_32 tr = (wr * v->re + wi * v->im) >> 15;
+                alt_32 ti = (wr * v->im - wi * v->re) >> 15;
+
+                v->re = (q15_t)((u->re - tr) >> 1);
+                v->im = (q15_t)((u->im - ti) >> 1);
+                u->re = (q15_t)((u->re + tr) >> 1);
+                u->im = (q15_t)((u->im + ti) >> 1);
+            }
+        }
+    }
+}
+
+/* ================================================================
+ *                      WINDOW AND MAGNITUDE
+ * ================================================================ */
+void fft_window_hann(complex_q15_t *x, unsigned log2n)
+{
+    const size_t n = (size_t)1 << log2n;
+    const unsigned step = FFT_MAX_LOG2 - log2n;
+
+    for (size_t i = 0; i < n; i++)
+    {
+        // (1 - cos(2 pi i / n)) / 2
+        alt_32 w = (32767 - cosine(i << step)) >> 1;
+
+        x[i].re = (q15_t)((x[i].re * w) >> 15);
+    }
+}
+
+alt_u16 fft_magnitude(complex_q15_t x)
+{
+    alt_u32 re = x.re < 0 ? -x.re : x.re;
+    alt_u32 im = x.im < 0 ? -x.im : x.im;
+    alt_u32 max = re > im ? re : im;
+    alt_u32 min = re > im ? im : re;
+
+    return (alt_u16)(max + (min >> 2) + (min >> 3));
+}
@@ -0,0 +1,43 @@
+#ifndef FFT_H_
+#define FFT_H_
+
+#include <stddef.h>
+#include <alt_types.h>
+#include "filter_pipeline.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  FIXED-POINT FFT
+ * ---------------------------------------------------------------------
+ *  Radix-2 decimation-in-time FFT of 2^log2n complex Q15 points
+ *  (FFT_MIN_LOG2..FFT_MAX_LOG2), computed in place. The twiddle factors
+ *  come from a precomputed quarter-wave sine table for FFT_MAX_POINTS;
+ *  smaller transforms step through it.
+ *
+ *  Every stage halves its outputs, so the result is the DFT divided by
+ *  n. Halving never lets a magnitude grow, so nothing overflows as
+ *  long as every input magnitude stays at or below FFT_INPUT_MAX.
+ *  The cost is fixed by n: n/2 * log2n butterflies of four multiplies.
+ * ---------------------------------------------------------------------
+ */
+
+#define FFT_MIN_LOG2    6
+#define FFT_MAX_LOG2    9
+#define FFT_MAX_POINTS  (1u << FFT_MAX_LOG2)
+#define FFT_INPUT_MAX   16383           // Half scale: room for rounding
+
+typedef struct complex_q15 {
+    q15_t re;
+    q15_t im;
+} complex_q15_t;
+
+// Forward transform in place, scaled by 1/n
+void fft_q15(complex_q15_t *x, unsigned log2n);
+
+// Multiply the real parts by a periodic Hann window of 2^log2n points
+void fft_window_hann(complex_q15_t *x, unsigned log2n);
+
+// |x| approximated as max + 3/8 min (within 7%), no square root
+alt_u16 fft_magnitude(complex_q15_t x);
+
+#endif /* FFT_H_ */
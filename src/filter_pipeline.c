@@ -0,0 +1,191 @@
+#include "filter_pipeline.h"
+#include "hot.h"
+#include "mac.h"
+
+static inline q15_t saturate_q15(alt_32 v)
+{
+    if (v > 32767)
+        return 32767;
+    if (v < -32768)
+        return -32768;
+    return (q15_t)v;
+}
+
+/* ================================================================
+ *                          PIPELINE
+ * ================================================================ */
+void filter_pipeline_init(filter_pipeline_t *p, const filter_stage_t *stages, size_t count)
+{
+    p->stages = stages;
+    p->count = count;
+}
+
+HOT_CODE size_t filter_pipeline_run(filter_pipeline_t *p, const q15_t *in, q15_t *out, size_t count)
+{
+    const q15_t *src = in;
+
+    if (count > FILTER_BLOCK)
+        count = FILTER_BLOCK;
+
+    // Ping-pong between the two scratch blocks; the last stage writes
+    // straight to out
+    for (size_t s = 0; s < p->count && count > 0; s++)
+    {
+        q15_t *dst = (s + 1 == p->count) ? out : p->scratch[s & 1];
+
+        count = p->stages[s].process(p->stages[s].state, src, dst, count);
+        src = dst;
+    }
+
+    if (p->count == 0)
+    {
+        for (size_t i = 0; i < count; i++)
+            out[i] = in[i];
+    }
+
+    return count;
+}
+
+/* ================================================================
+ *                          BIQUAD
+ * ================================================================ */
+void biquad_init(biquad_t *f, alt_16 b0, alt_16 b1, alt_16 b2, alt_16 a1, alt_16 a2)
+{
+    f->b0 = b0;
+    f->b1 = b1;
+    f->b2 = b2;
+    f->a1 = a1;
+    f->a2 = a2;
+    f->x1 = f->x2 = f->y1 = f->y2 = 0;
+}
+
+HOT_CODE size_t biquad_process(void *state, const q15_t *in, q15_t *out, size_t count)
+{
+    biquad_t *f = state;
+    q15_t x1 = f->x1, x2 = f->x2, y1 = f->y1, y2 = f->y2;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        // Q15 * Q14 products, |sum| < 2^31 for the documented headroom
+        alt_32 acc = (alt_32)f->b0 * in[i] + (alt_32)f->b1 * x1 + (alt_32)f->b2 * x2
+                   - (alt_32)f->a1 * y1 - (alt_32)f->a2 * y2;
+        q15_t y = saturate_q15((acc + (1 << 13)) >> 14);
+
+        x2 = x1;
+        x1 = in[i];
+        y2 = y1;
+        y1 = y;
+        out[i] = y;
+    }
+
+    f->x1 = x1;
+    f->x2 = x2;
+    f->y1 = y1;
+    f->y2 = y2;
+    return count;
+}
+
+/* ================================================================
+ *                            FIR
+ * ================================================================ */
+void fir_init(fir_t *f, const q15_t *coeffs, size_t taps)
+{
+    f->taps = taps > FIR_MAX_TAPS ? FIR_MAX_TAPS : taps;
+
+    for (size_t k = 0; k < f->taps; k++)
+        f->reversed[k] = coeffs[f->taps - 1 - k];
+
+    for (size_t i = 0; i < FIR_MAX_TAPS - 1 + FILTER_BLOCK; i++)
+        f->line[i] = 0;
+}
+
+HOT_CODE size_t fir_process(void *state, const q15_t *in, q15_t *out, size_t count)
+{
+    fir_t *f = state;
+    const size_t history = f->taps - 1;
+
+    for (size_t i = 0; i < count; i++)
+        f->line[history + i] = in[i];
+
+    mac_fir_block(f->reversed, f->taps, f->line, out, count);
+
+    // Keep the newest taps - 1 samples for the next block
+    for (size_t i = 0; i < history; i++)
+        f->line[i] = f->line[count + i];
+
+    return count;
+}
+
+/* ================================================================
+ *                          MEDIAN
+ * ================================================================ */
+void median_init(median_t *f, size_t window)
+{
+    if (window > MEDIAN_MAX_WINDOW)
+        window = MEDIAN_MAX_WINDOW;
+
+    f->window = window | 1;    // Force odd
+    if (f->window > MEDIAN_MAX_WINDOW)
+        f->window -= 2;
+
+    f->index = 0;
+
+    for (size_t i = 0; i < MEDIAN_MAX_WINDOW; i++)
+        f->history[i] = 0;
+}
+
+HOT_CODE size_t median_process(void *state, const q15_t *in, q15_t *out, size_t count)
+{
+    median_t *f = state;
+    q15_t sorted[MEDIAN_MAX_WINDOW];
+
+    for (size_t i = 0; i < count; i++)
+    {
+        f->history[f->index] = in[i];
+        f->index = f->index + 1 == f->window ? 0 : f->index + 1;
+
+        // Insertion sort of a handful of samples
+        for (size_t j = 0; j < f->window; j++)
+        {
+            q15_t v = f->history[j];
+            size_t k = j;
+
+            while (k > 0 && sorted[k - 1] > v)
+            {
+                sorted[k] = sorted[k - 1];
+                k--;
+            }
+
+            sorted[k] = v;
+        }
+
+        out[i] = sorted[f->window >> 1];
+    }
+
+    return count;
+}
+
+/* ================================================================
+ *                        DECIMATOR
+ * ================================================================ */
+void decimator_init(decimator_t *f, size_t factor)
+{
+    f->factor = factor ? factor : 1;
+    f->phase = 0;
+}
+
+HOT_CODE size_t decimator_process(void *state, const q15_t *in, q15_t *out, size_t count)
+{
+    decimator_t *f = state;
+    size_t produced = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (f->phase == 0)
+            out[produced++] = in[i];
+
+        f->phase = f->phase + 1 == f->factor ? 0 : f->phase + 1;
+    }
+
+    return produced;
+}
@@ -0,0 +1,93 @@
+#ifndef FILTER_PIPELINE_H_
+#define FILTER_PIPELINE_H_
+
+#include <stddef.h>
+#include <alt_types.h>
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  FIXED-POINT FILTER PIPELINE
+ * ---------------------------------------------------------------------
+ *  Chain of block-processing stages on Q15 samples (one axis per
+ *  pipeline). Every stage consumes a block and produces a block of the
+ *  same or (for decimation) smaller length, so the per-call overhead is
+ *  paid once per block rather than once per sample. All arithmetic is
+ *  integer with 32-bit accumulators; the accumulator headroom notes
+ *  below assume |sum of |coefficients|| stays under 2.
+ * ---------------------------------------------------------------------
+ */
+
+typedef alt_16 q15_t;
+
+typedef struct filter_stage filter_stage_t;
+
+// Process count samples from in to out, return the output count.
+// in and out never alias.
+typedef size_t (*filter_fn_t)(void *state, const q15_t *in, q15_t *out, size_t count);
+
+struct filter_stage {
+    filter_fn_t process;
+    void *state;
+};
+
+typedef struct filter_pipeline {
+    const filter_stage_t *stages;
+    size_t count;
+    q15_t scratch[2][FILTER_BLOCK];
+} filter_pipeline_t;
+
+void filter_pipeline_init(filter_pipeline_t *p, const filter_stage_t *stages, size_t count);
+
+// Run a block (count <= FILTER_BLOCK) through every stage
+size_t filter_pipeline_run(filter_pipeline_t *p, const q15_t *in, q15_t *out, size_t count);
+
+/* ---------------------------- BIQUAD ------------------------------- */
+
+// Direct form I, coefficients in Q14 (a0 normalised to 1, a1/a2 with
+// the sign used in y = b0x0 + b1x1 + b2x2 - a1y1 - a2y2)
+typedef struct biquad {
+    alt_16 b0, b1, b2, a1, a2;
+    q15_t x1, x2, y1, y2;
+} biquad_t;
+
+void biquad_init(biquad_t *f, alt_16 b0, alt_16 b1, alt_16 b2, alt_16 a1, alt_16 a2);
+size_t biquad_process(void *state, const q15_t *in, q15_t *out, size_t count);
+
+/* ----------------------------- FIR --------------------------------- */
+
+// Coefficients in Q15. Each block is convolved in one mac_fir_block()
+// call over [taps - 1 history samples | new block].
+typedef struct fir {
+    size_t taps;                        // <= FIR_MAX_TAPS
+    q15_t reversed[FIR_MAX_TAPS];       // Time-reversed coefficients
+    q15_t line[FIR_MAX_TAPS - 1 + FILTER_BLOCK];
+} fir_t;
+
+void fir_init(fir_t *f, const q15_t *coeffs, size_t taps);
+size_t fir_process(void *state, const q15_t *in, q15_t *out, size_t count);
+
+/* ---------------------------- MEDIAN ------------------------------- */
+
+// Median of the last window samples (odd, <= MEDIAN_MAX_WINDOW)
+typedef struct median {
+    size_t window;
+    size_t index;
+    q15_t history[MEDIAN_MAX_WINDOW];
+} median_t;
+
+void median_init(median_t *f, size_t window);
+size_t median_process(void *state, const q15_t *in, q15_t *out, size_t count);
+
+/* --------------------------- DECIMATOR ----------------------------- */
+
+// Keep every factor-th sample (precede with a low-pass stage)
+typedef struct decimator {
+    size_t factor;
+    size_t phase;
+} decimator_t;
+
+void decimator_init(decimator_t *f, size_t factor);
+size_t decimator_process(void *state, const q15_t *in, q15_t *out, size_t count);
+
+#endif /* FILTER_PIPELINE_H_ */
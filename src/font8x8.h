@@ -0,0 +1,17 @@
+#ifndef FONT8X8_H_
+#define FONT8X8_H_
+
+#include <alt_types.h>
+
+/*
+ * 8x8 bitmap font for printable ASCII (0x20..0x7E). One byte per row,
+ * bit 0 is the leftmost pixel. Based on the public domain IBM PC BIOS
+ * font (font8x8_basic).
+ */
+
+#define FONT8X8_FIRST 0x20
+#define FONT8X8_LAST  0x7E
+
+extern const alt_u8 font8x8[FONT8X8_LAST - FONT8X8_FIRST + 1][8];
+
+#endif /* FONT8X8_H_ */
@@ -0,0 +1,173 @@
+#include <DE10_Lite_VGA_Driver.h>
+#include "app_config.h"
+#include "font8x8.h"
+#include "gfx.h"
+
+/* ================================================================
+ *                           TEXT
+ * ================================================================ */
+static void draw_char(size_t x, size_t y, char c, vga_color_t fg, vga_color_t bg)
+{
+    if (c < FONT8X8_FIRST || c > FONT8X8_LAST)
+        c = '?';
+
+    fb_glyph(x, y, font8x8[c - FONT8X8_FIRST], fg, bg);
+}
+
+void gfx_text(size_t x, size_t y, const char *text, vga_color_t fg, vga_color_t bg)
+{
+    for (; *text; text++, x += VGA_CHAR_WIDTH)
+        draw_char(x, y, *text, fg, bg);
+}
+
+// Nios II without a hardware divider would call a library routine for
+// every / and %: count down powers of ten instead
+static const alt_u32 powers_of_ten[GFX_INT_MAX_DIGITS] = {
+    1000000000, 100000000, 10000000, 1000000, 100000,
+    10000, 1000, 100, 10, 1
+};
+
+size_t gfx_format_int(char *buf, int value, size_t digits)
+{
+    alt_u32 v = value < 0 ? -(alt_u32)value : (alt_u32)value;
+    size_t first = GFX_INT_MAX_DIGITS - (digits < GFX_INT_MAX_DIGITS ? digits : GFX_INT_MAX_DIGITS);
+    size_t n = 1;
+    bool leading = true;
+
+    buf[0] = value < 0 ? '-' : ' ';
+
+    for (size_t i = 0; i < GFX_INT_MAX_DIGITS; i++)
+    {
+        alt_u32 p = powers_of_ten[i];
+        char d = '0';
+
+        while (v >= p)
+        {
+            v -= p;
+            d++;
+        }
+
+        if (i < first)
+        {
+            // Digit does not fit in the field; the rest is then shown
+            // with its zeros like a truncated number
+            if (d != '0')
+                leading = false;
+            continue;
+        }
+
+        if (d != '0' || i == GFX_INT_MAX_DIGITS - 1)
+            leading = false;
+
+        buf[n++] = leading ? ' ' : d;
+    }
+
+    buf[n] = '\0';
+    return n;
+}
+
+void gfx_int(size_t x, size_t y, int value, size_t digits, vga_color_t fg, vga_color_t bg)
+{
+    char buf[GFX_INT_MAX_DIGITS + 2];
+
+    gfx_format_int(buf, value, digits);
+    gfx_text(x, y, buf, fg, bg);
+}
+
+void gfx_field_init(gfx_field_t *field, size_t x, size_t y, size_t digits, vga_color_t fg, vga_color_t bg)
+{
+    field->x = x;
+    field->y = y;
+    field->digits = digits < GFX_INT_MAX_DIGITS ? digits : GFX_INT_MAX_DIGITS;
+    field->valid = false;
+    field->fg = fg;
+    field->bg = bg;
+}
+
+void gfx_field_draw(gfx_field_t *field, int value)
+{
+    char buf[GFX_INT_MAX_DIGITS + 2];
+    size_t n = gfx_format_int(buf, value, field->digits);
+
+    for (size_t i = 0; i < n; i++)
+    {
+        if (field->valid && buf[i] == field->shown[i])
+            continue;
+
+        draw_char(field->x + i * VGA_CHAR_WIDTH, field->y, buf[i], field->fg, field->bg);
+        field->shown[i] = buf[i];
+    }
+
+    field->valid = true;
+}
+
+#if VGA_DOUBLE_BUFFER
+
+/* ================================================================
+ *                  BACK-BUFFER RASTERISATION
+ * ================================================================ */
+void gfx_clear(vga_color_t color)
+{
+    fb_fill_rect(0, 0, CANVAS_WIDTH - 1, CANVAS_HEIGHT - 1, color);
+}
+
+void gfx_hline(size_t x, size_t y, size_t length, vga_color_t color)
+{
+    if (length > 0 && y < CANVAS_HEIGHT)
+        fb_fill_rect(x, y, x + length - 1, y, color);
+}
+
+void gfx_vline(size_t x, size_t y, size_t length, vga_color_t color)
+{
+    if (length > 0 && x < CANVAS_WIDTH)
+        fb_fill_rect(x, y, x, y + length - 1, color);
+}
+
+void gfx_circle(size_t x, size_t y, size_t radius, vga_color_t color)
+{
+    int r = radius;
+
+    // One span per row of the disc
+    for (int dy = -r; dy <= r; dy++)
+    {
+        int dx = 0;
+
+        while ((dx + 1) * (dx + 1) + dy * dy <= r * r)
+            dx++;
+
+        int row = (int)y + dy;
+        int x0 = (int)x - dx;
+
+        if (row < 0)
+            continue;
+
+        fb_fill_rect(x0 < 0 ? 0 : x0, row, x + dx, row, color);
+    }
+}
+
+#else
+
+/* ================================================================
+ *                  DIRECT DRIVER FORWARDING
+ * ================================================================ */
+void gfx_clear(vga_color_t color)
+{
+    clear_screen(color);
+}
+
+void gfx_hline(size_t x, size_t y, size_t length, vga_color_t color)
+{
+    draw_hline(x, y, length, color);
+}
+
+void gfx_vline(size_t x, size_t y, size_t length, vga_color_t color)
+{
+    draw_vline(x, y, length, color);
+}
+
+void gfx_circle(size_t x, size_t y, size_t radius, vga_color_t color)
+{
+    draw_filled_circle(x, y, radius, color);
+}
+
+#endif /* VGA_DOUBLE_BUFFER */
@@ -0,0 +1,50 @@
+#ifndef GFX_H_
+#define GFX_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "vga_fb.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  DRAWING PRIMITIVES
+ * ---------------------------------------------------------------------
+ *  Same calls as the DE10-Lite VGA driver. With VGA_DOUBLE_BUFFER off
+ *  the shapes forward to the driver; with it on they rasterise into
+ *  the back buffer kept by vga_fb. Text always goes through
+ *  fb_glyph() with the built-in 8x8 font.
+ *
+ *  A gfx_field_t is a numeric field that remembers what it shows, so
+ *  gfx_field_draw() only repaints the character cells that changed.
+ * ---------------------------------------------------------------------
+ */
+
+void gfx_clear(vga_color_t color);
+void gfx_hline(size_t x, size_t y, size_t length, vga_color_t color);
+void gfx_vline(size_t x, size_t y, size_t length, vga_color_t color);
+void gfx_circle(size_t x, size_t y, size_t radius, vga_color_t color);
+void gfx_text(size_t x, size_t y, const char *text, vga_color_t fg, vga_color_t bg);
+void gfx_int(size_t x, size_t y, int value, size_t digits, vga_color_t fg, vga_color_t bg);
+
+#define GFX_INT_MAX_DIGITS 10
+
+// Format value as gfx_int() shows it: a sign cell, then right-aligned
+// digits (higher digits are dropped). Uses no division. Returns the
+// length, digits + 1; buf needs GFX_INT_MAX_DIGITS + 2 bytes.
+size_t gfx_format_int(char *buf, int value, size_t digits);
+
+typedef struct gfx_field {
+    alt_u16 x;
+    alt_u16 y;
+    alt_u8 digits;
+    bool valid;                             // shown[] is on screen
+    vga_color_t fg;
+    vga_color_t bg;
+    char shown[GFX_INT_MAX_DIGITS + 2];
+} gfx_field_t;
+
+// Set up a field; nothing is drawn until the first gfx_field_draw()
+void gfx_field_init(gfx_field_t *field, size_t x, size_t y, size_t digits, vga_color_t fg, vga_color_t bg);
+void gfx_field_draw(gfx_field_t *field, int value);
+
+#endif /* GFX_H_ */
@@ -0,0 +1,127 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include "altera_avalon_sierra_ker.h"
+#include "host_stream.h"
+#include "log.h"
+#include "sample_ring.h"
+#include "task_stats.h"
+
+/* ================================================================
+ *                          CRC-16
+ *  Nibble table: two lookups per byte, 32 bytes of table.
+ * ================================================================ */
+static const alt_u16 crc_nibble[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+alt_u16 host_crc16(const alt_u8 *data, size_t length)
+{
+    alt_u16 crc = 0xFFFF;
+
+    for (size_t i = 0; i < length; i++)
+    {
+        crc = (crc << 4) ^ crc_nibble[(crc >> 12) ^ (data[i] >> 4)];
+        crc = (crc << 4) ^ crc_nibble[(crc >> 12) ^ (data[i] & 0x0F)];
+    }
+
+    return crc;
+}
+
+#if HOST_STREAM
+
+static void put16(alt_u8 *p, alt_u16 v)
+{
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+static void put32(alt_u8 *p, alt_u32 v)
+{
+    put16(p, v & 0xFFFF);
+    put16(p + 2, v >> 16);
+}
+
+static void pack_frame(alt_u8 *f, alt_u16 seq, const acc_sample_t *s)
+{
+    put16(f, HOST_FRAME_SYNC);
+    put16(f + 2, seq);
+    put32(f + 4, s->timestamp);
+    put16(f + 8, (alt_u16)s->pos.x);
+    put16(f + 10, (alt_u16)s->pos.y);
+    put16(f + 12, (alt_u16)s->pos.z);
+    put16(f + 14, host_crc16(f + 2, 12));
+}
+
+/* ================================================================
+ *                       STREAMING TASK
+ *  Each period packs everything the acquisition task produced into
+ *  the frame buffer and writes as much of it as the port accepts
+ *  without blocking. What is left goes out first next period; new
+ *  samples are only packed once the buffer has been sent, and the
+ *  ring's lost count (visible as sequence gaps) absorbs the rest.
+ * ================================================================ */
+void host_stream_task_code(void)
+{
+    static task_stats_t stats;
+    static alt_u8 buffer[HOST_STREAM_BATCH * HOST_FRAME_SIZE];
+    static acc_sample_t batch[HOST_STREAM_BATCH];
+    sample_cursor_t cursor;
+    size_t filled = 0;      // Bytes packed into buffer
+    size_t sent = 0;        // Bytes of buffer already written
+    int fd;
+
+    init_period_time(HOST_STREAM_PERIOD_TICKS);
+    task_stats_init(&stats, "STREAM", HOST_STREAM_PERIOD_TICKS);
+
+    fd = open(HOST_STREAM_DEV, O_WRONLY | O_NONBLOCK);
+    if (fd < 0)
+        LOG("Host stream: cannot open %s\n", HOST_STREAM_DEV);
+
+    sample_cursor_init(&acc_ring, &cursor);
+
+    while (1)
+    {
+        task_stats_wait(&stats);
+
+        if (fd < 0)
+            continue;
+
+        ssize_t n;
+        size_t chunk;
+
+        do
+        {
+            if (sent == filled)
+            {
+                // Sequence numbers follow the ring index, so samples
+                // the stream skipped show up as gaps on the host
+                size_t count = sample_ring_read(&acc_ring, &cursor, batch, HOST_STREAM_BATCH);
+                alt_u32 first = cursor.next - count;
+
+                for (size_t i = 0; i < count; i++)
+                    pack_frame(&buffer[i * HOST_FRAME_SIZE], (alt_u16)(first + i), &batch[i]);
+
+                filled = count * HOST_FRAME_SIZE;
+                sent = 0;
+            }
+
+            if (filled == 0)
+                break;
+
+            // HOST_STREAM_DEV is normally the console's JTAG UART; the
+            // lock covers one write of at most CONSOLE_LINE_MAX bytes,
+            // like every console section (log.h)
+            chunk = filled - sent < CONSOLE_LINE_MAX ? filled - sent : CONSOLE_LINE_MAX;
+            mutex_lock(&console_mutex);
+            n = write(fd, &buffer[sent], chunk);
+            mutex_unlock(&console_mutex);
+            if (n <= 0)
+                break;  // Port full (EWOULDBLOCK): retry next period
+
+            sent += n;
+        } while ((size_t)n == chunk);
+    }
+}
+
+#endif /* HOST_STREAM */
@@ -0,0 +1,43 @@
+#ifndef HOST_STREAM_H_
+#define HOST_STREAM_H_
+
+#include <stddef.h>
+#include <alt_types.h>
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  HOST SAMPLE STREAM
+ * ---------------------------------------------------------------------
+ *  With HOST_STREAM enabled a low-rate task packs every sample of the
+ *  acquisition ring into a 16-byte binary frame and writes the frames
+ *  to HOST_STREAM_DEV in large non-blocking writes. Nothing is
+ *  formatted as text; tools/stream_receiver.py turns the stream back
+ *  into samples.
+ *
+ *  Frame layout (little-endian):
+ *    u16 sync  0x5AA5
+ *    u16 seq   index of the sample in the ring (gaps = lost samples)
+ *    u32 timestamp (alt_timestamp() ticks)
+ *    i16 x, y, z
+ *    u16 crc   CRC-16/CCITT-FALSE over seq..z
+ *
+ *  The receiver resynchronises on the sync word and the CRC, so other
+ *  console output on the same port (logs, dumps) is skipped.
+ * ---------------------------------------------------------------------
+ */
+
+#define HOST_FRAME_SYNC  0x5AA5
+#define HOST_FRAME_SIZE  16
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+alt_u16 host_crc16(const alt_u8 *data, size_t length);
+
+#if HOST_STREAM
+
+// Task entry point (task table)
+void host_stream_task_code(void);
+
+#endif
+
+#endif /* HOST_STREAM_H_ */
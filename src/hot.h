@@ -0,0 +1,22 @@
+#ifndef HOT_H_
+#define HOT_H_
+
+#include "app_config.h"
+
+/*
+ * Acquisition hot path placement. With HOT_MEMORY the code and data
+ * tagged here are collected into the on-chip memory named by HOT_REGION
+ * (hot.ld, src/Makefile), so the ISR, the acquisition and filter tasks
+ * and the buffers they touch never wait behind framebuffer traffic on
+ * SDRAM. Only writable data may be HOT_DATA: mixing const and non-const
+ * objects in one section is a section type conflict.
+ */
+#if HOT_MEMORY
+#define HOT_CODE __attribute__((section(".hot.text")))
+#define HOT_DATA __attribute__((section(".hot.data")))
+#else
+#define HOT_CODE
+#define HOT_DATA
+#endif
+
+#endif /* HOT_H_ */
@@ -0,0 +1,124 @@
+#include <altera_avalon_pio_regs.h>
+#include <sys/alt_timestamp.h>
+#include "system.h"
+#include "app_config.h"
+#include "analytics.h"
+#include "dma.h"
+#include "idle.h"
+#include "log.h"
+#include "mutex.h"
+#include "render.h"
+#include "task_stats.h"
+#include "tasks.h"
+#include "trace.h"
+
+static volatile alt_u32 load_last;
+static volatile alt_u32 load_max;
+
+alt_u32 idle_cpu_load(void)
+{
+    return load_last;
+}
+
+alt_u32 idle_cpu_load_max(void)
+{
+    return load_max;
+}
+
+// Busy-wait without touching memory or peripherals
+static void spin(void)
+{
+    for (int i = 0; i < IDLE_SPIN_LOOPS; i++)
+        __asm__ __volatile__("nop");
+}
+
+/* ================================================================
+ *                      BACKGROUND WORK
+ *  KEY0 dumps the task timing and stack tables, KEY1 the event trace
+ *  (buttons read 0 while pressed).
+ * ================================================================ */
+static void background_work(void)
+{
+    static int last_buttons = 0x3;
+    int buttons;
+
+    // All console output from the tasks is printed from here
+    log_drain();
+
+#ifdef HOST_MSGDMA_NAME
+    dma_host_poll();
+#endif
+
+    buttons = 0x3 & IORD_ALTERA_AVALON_PIO_DATA(PIO_BUTTONS_IN_BASE);
+
+    if (!(buttons & 0x1) && (last_buttons & 0x1))
+    {
+        task_stats_dump();
+        tasks_stack_report();
+        mutex_report();
+        analytics_report();
+        render_report();
+
+        console_printf("CPU load %lu.%lu%% (max %lu.%lu%%)\n",
+                       (unsigned long)(load_last / 10), (unsigned long)(load_last % 10),
+                       (unsigned long)(load_max / 10), (unsigned long)(load_max % 10));
+        console_printf("dropped: %lu log messages, %lu console bytes\n",
+                       (unsigned long)log_dropped(), (unsigned long)console_dropped());
+    }
+
+    if (!(buttons & 0x2) && (last_buttons & 0x2))
+        trace_dump();
+
+    last_buttons = buttons;
+}
+
+/* ================================================================
+ *                         IDLE LOOP
+ * ================================================================ */
+void idle_code(void)
+{
+    const alt_u32 freq = alt_timestamp_freq();
+    const alt_u32 gap = freq / 1000000 * IDLE_GAP_US;
+    const alt_u32 work_interval = freq / 1000000 * IDLE_WORK_US;
+    const alt_u32 window = freq;           // One second
+
+    alt_u32 last = alt_timestamp();
+    alt_u32 window_start = last;
+    alt_u32 last_work = last;
+    alt_u32 idle_ticks = 0;
+
+    console_printf("Idle task started\n");
+
+    while (1)
+    {
+        spin();
+
+        alt_u32 now = alt_timestamp();
+        alt_u32 delta = now - last;
+        last = now;
+
+        // A long pass means a task preempted the spin
+        if (delta <= gap)
+            idle_ticks += delta;
+
+        if (now - window_start >= window)
+        {
+            alt_u32 elapsed = now - window_start;
+            alt_u32 busy = 1000 - (alt_u32)((alt_u64)idle_ticks * 1000 / elapsed);
+
+            load_last = busy;
+            if (busy > load_max)
+                load_max = busy;
+
+            window_start = now;
+            idle_ticks = 0;
+        }
+
+        if (now - last_work >= work_interval)
+        {
+            background_work();
+            last_work = now;
+            last = alt_timestamp();     // Not idle time
+        }
+    }
+}
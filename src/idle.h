@@ -0,0 +1,31 @@
+#ifndef IDLE_H_
+#define IDLE_H_
+
+#include <alt_types.h>
+
+/*
+ * ---------------------------------------------------------------------
+ *  IDLE TASK
+ * ---------------------------------------------------------------------
+ *  Runs whenever no periodic task is ready. Background work (log
+ *  draining, the push-button dumps) is done at most once every
+ *  IDLE_WORK_US; in between the task spins on a short register-only
+ *  delay so it generates no bus traffic. Nios II has no
+ *  wait-for-interrupt instruction and the core clock is fixed, so a
+ *  cache-resident spin is the cheapest state available.
+ *
+ *  Every pass through the spin is timed with alt_timestamp(). Passes
+ *  that took no longer than IDLE_GAP_US were not preempted and count
+ *  as idle time; the rest were taken by the tasks. The CPU load is
+ *  derived from that over one-second windows.
+ * ---------------------------------------------------------------------
+ */
+
+void idle_code(void);
+
+// CPU load in per mille over the last complete window, and the
+// highest window seen so far
+alt_u32 idle_cpu_load(void);
+alt_u32 idle_cpu_load_max(void);
+
+#endif /* IDLE_H_ */
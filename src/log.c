@@ -0,0 +1,180 @@
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/alt_irq.h>
+#include <sys/alt_timestamp.h>
+#include "system.h"
+#include "barrier.h"
+#include "log.h"
+
+#define LOG_RING_MASK (LOG_RING_SIZE - 1)
+
+#if (LOG_RING_SIZE & LOG_RING_MASK) != 0
+#error "LOG_RING_SIZE must be a power of two"
+#endif
+
+typedef struct log_entry {
+    const char *fmt;
+    log_arg_t args[3];
+} log_entry_t;
+
+static log_entry_t ring[LOG_RING_SIZE];
+static volatile alt_u32 head;       // Slots reserved by producers
+static volatile alt_u32 tail;       // Slots printed by log_drain()
+static volatile alt_u32 dropped;
+
+mutex_t console_mutex;
+static int console_fd = -1;
+static alt_u32 console_lost;     // Updated under console_mutex
+
+/* ================================================================
+ *                      PRODUCERS
+ *  Any task or ISR. The slot is reserved with interrupts disabled
+ *  and filled in afterwards. log_drain() only runs in the idle task,
+ *  which cannot be scheduled while a task is half-way through an
+ *  entry, so it never sees a partly written slot.
+ * ================================================================ */
+void log_write(const char *fmt, log_arg_t a, log_arg_t b, log_arg_t c)
+{
+    alt_irq_context ctx = alt_irq_disable_all();
+    alt_u32 slot = head;
+
+    if (slot - tail >= LOG_RING_SIZE)
+    {
+        dropped++;
+        alt_irq_enable_all(ctx);
+        return;
+    }
+
+    head = slot + 1;
+    alt_irq_enable_all(ctx);
+
+    log_entry_t *e = &ring[slot & LOG_RING_MASK];
+    e->fmt = fmt;
+    e->args[0] = a;
+    e->args[1] = b;
+    e->args[2] = c;
+}
+
+/* ================================================================
+ *                      CONSUMER
+ * ================================================================ */
+void log_drain(void)
+{
+    alt_u32 end = head;
+    compiler_barrier();
+
+    while (tail != end)
+    {
+        const log_entry_t *e = &ring[tail & LOG_RING_MASK];
+
+        console_printf(e->fmt, e->args[0], e->args[1], e->args[2]);
+
+        compiler_barrier();     // Entry consumed before the slot is freed
+        tail++;
+    }
+}
+
+alt_u32 log_dropped(void)
+{
+    return dropped;
+}
+
+/* ================================================================
+ *                          CONSOLE
+ * ================================================================ */
+void console_init(void)
+{
+    fflush(stdout);         // Start-up output first
+    console_fd = open(CONSOLE_DEV, O_WRONLY | O_NONBLOCK);
+}
+
+// One write() of at most CONSOLE_LINE_MAX bytes under the lock;
+// returns the bytes the driver took
+static size_t console_try_write(const char *data, size_t length)
+{
+    ssize_t n = -1;
+
+    if (length > CONSOLE_LINE_MAX)
+        length = CONSOLE_LINE_MAX;
+
+    mutex_lock(&console_mutex);
+    if (console_fd >= 0)
+        n = write(console_fd, data, length);
+    mutex_unlock(&console_mutex);
+
+    return n > 0 ? (size_t)n : 0;
+}
+
+void console_write(const void *data, size_t length)
+{
+    const char *p = data;
+
+    while (length > 0)
+    {
+        size_t n = console_try_write(p, length);
+
+        p += n;
+        length -= n;
+
+        if (n == 0)
+            break;
+    }
+
+    // Driver buffer full: drop the rest rather than wait
+    if (length > 0)
+    {
+        mutex_lock(&console_mutex);
+        console_lost += length;
+        mutex_unlock(&console_mutex);
+    }
+}
+
+bool console_write_all(const void *data, size_t length)
+{
+    const alt_u32 stall = alt_timestamp_freq() / 1000000 * CONSOLE_STALL_US;
+    const char *p = data;
+    alt_u32 progress = alt_timestamp();
+
+    while (length > 0)
+    {
+        size_t n = console_try_write(p, length);
+
+        if (n > 0)
+        {
+            p += n;
+            length -= n;
+            progress = alt_timestamp();
+        }
+        else if (alt_timestamp() - progress > stall)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void console_printf(const char *fmt, ...)
+{
+    char line[CONSOLE_LINE_MAX];
+    va_list args;
+    int n;
+
+    va_start(args, fmt);
+    n = vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+
+    if (n < 0)
+        return;
+    if ((size_t)n >= sizeof(line))
+        n = sizeof(line) - 1;
+
+    console_write(line, (size_t)n);
+}
+
+alt_u32 console_dropped(void)
+{
+    return console_lost;
+}
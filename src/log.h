@@ -0,0 +1,69 @@
+#ifndef LOG_H_
+#define LOG_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <alt_types.h>
+#include "app_config.h"
+#include "mutex.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  DEFERRED LOGGING
+ * ---------------------------------------------------------------------
+ *  LOG() stores the format pointer and up to three word-sized
+ *  arguments in a ring and returns; nothing is formatted or written
+ *  to the JTAG UART until the idle task calls log_drain(). A task
+ *  therefore never blocks on the UART, whether or not a host is
+ *  attached. When the ring is full new messages are dropped and
+ *  counted.
+ *
+ *  The format must be a string literal. Arguments are stored as
+ *  uintptr_t (one word on Nios II): use %d, %u, %x or %c, and %s only
+ *  for strings with static storage.
+ *
+ *  After start-up nothing calls printf(). console_printf() formats
+ *  into a CONSOLE_LINE_MAX buffer on the caller's stack, outside any
+ *  lock, and console_write() holds console_mutex only around one
+ *  non-blocking write() of at most CONSOLE_LINE_MAX bytes to
+ *  CONSOLE_DEV; the HAL driver is not reentrant. Bytes the driver
+ *  has no room for (no host reading) are dropped and counted, so a
+ *  section never waits on the UART and stays within CONSOLE_CS_US.
+ * ---------------------------------------------------------------------
+ */
+
+typedef uintptr_t log_arg_t;
+
+#define LOG(...) LOG_ARGS_(__VA_ARGS__, 0, 0, 0)
+#define LOG_ARGS_(fmt, a, b, c, ...) \
+    log_write(fmt, (log_arg_t)(a), (log_arg_t)(b), (log_arg_t)(c))
+
+void log_write(const char *fmt, log_arg_t a, log_arg_t b, log_arg_t c);
+
+// Format and print every pending message (idle task only)
+void log_drain(void);
+
+// Messages lost because the ring was full
+alt_u32 log_dropped(void);
+
+extern mutex_t console_mutex;
+
+// Open CONSOLE_DEV for non-blocking writes (before tsw_on())
+void console_init(void);
+
+// Write up to CONSOLE_LINE_MAX bytes per console_mutex section
+void console_write(const void *data, size_t length);
+
+// Same, but retry while the driver is full, with the lock released
+// between attempts; false after CONSOLE_STALL_US without progress.
+// For binary dumps from the idle task, which cannot afford gaps.
+bool console_write_all(const void *data, size_t length);
+
+// Format outside the lock, then console_write() (cut at CONSOLE_LINE_MAX)
+void console_printf(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+// Console bytes lost because the driver's buffer was full
+alt_u32 console_dropped(void);
+
+#endif /* LOG_H_ */
@@ -0,0 +1,82 @@
+#include <stdint.h>
+#include "hot.h"
+#include "mac.h"
+
+static inline alt_16 saturate_q15(alt_32 v)
+{
+    if (v > 32767)
+        return 32767;
+    if (v < -32768)
+        return -32768;
+    return (alt_16)v;
+}
+
+#ifdef MAC_CI_N
+
+#define MAC_CI_CLEAR_ACC  0
+#define MAC_CI_ACC        1
+
+// Word loads of int16 pairs must be allowed to alias the samples
+typedef alt_32 __attribute__((may_alias)) q15_pair_t;
+
+static inline alt_u32 pack(const alt_16 *p)
+{
+    return (alt_u16)p[0] | ((alt_u32)(alt_u16)p[1] << 16);
+}
+
+HOT_CODE alt_32 mac_dot_q15(const alt_16 *a, const alt_16 *b, size_t n)
+{
+    alt_32 acc = __builtin_custom_inii(MAC_CI_N + MAC_CI_CLEAR_ACC, 0, 0);
+    size_t i = 0;
+
+    if ((((uintptr_t)a | (uintptr_t)b) & 0x3) == 0)
+    {
+        // Both word aligned: one 32-bit load per pair
+        const q15_pair_t *wa = (const q15_pair_t *)a;
+        const q15_pair_t *wb = (const q15_pair_t *)b;
+
+        for (; i + 1 < n; i += 2)
+            acc = __builtin_custom_inii(MAC_CI_N + MAC_CI_ACC, *wa++, *wb++);
+    }
+    else
+    {
+        for (; i + 1 < n; i += 2)
+            acc = __builtin_custom_inii(MAC_CI_N + MAC_CI_ACC, pack(&a[i]), pack(&b[i]));
+    }
+
+    // Odd tail: the high halves are zero
+    if (i < n)
+        acc = __builtin_custom_inii(MAC_CI_N + MAC_CI_ACC, (alt_u16)a[i], (alt_u16)b[i]);
+
+    return acc;
+}
+
+#else
+
+HOT_CODE alt_32 mac_dot_q15(const alt_16 *a, const alt_16 *b, size_t n)
+{
+    alt_32 acc = 0;
+    size_t i = 0;
+
+    // Unrolled by four to keep the multiplier busy between loads
+    for (; i + 3 < n; i += 4)
+    {
+        acc += (alt_32)a[i]     * b[i];
+        acc += (alt_32)a[i + 1] * b[i + 1];
+        acc += (alt_32)a[i + 2] * b[i + 2];
+        acc += (alt_32)a[i + 3] * b[i + 3];
+    }
+
+    for (; i < n; i++)
+        acc += (alt_32)a[i] * b[i];
+
+    return acc;
+}
+
+#endif /* MAC_CI_N */
+
+HOT_CODE void mac_fir_block(const alt_16 *h, size_t taps, const alt_16 *x, alt_16 *out, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+        out[i] = saturate_q15((mac_dot_q15(h, &x[i], taps) + (1 << 14)) >> 15);
+}
@@ -0,0 +1,33 @@
+#ifndef MAC_H_
+#define MAC_H_
+
+#include <stddef.h>
+#include <alt_types.h>
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  MULTIPLY-ACCUMULATE KERNELS
+ * ---------------------------------------------------------------------
+ *  Q15 dot products for the filter hot path. With MAC_CI_N defined the
+ *  inner loop runs on a Nios II custom instruction that multiplies two
+ *  packed int16 pairs and adds both products to an internal
+ *  accumulator:
+ *
+ *      n = MAC_CI_N + 0 : acc  = a.lo*b.lo + a.hi*b.hi, returns acc
+ *      n = MAC_CI_N + 1 : acc += a.lo*b.lo + a.hi*b.hi, returns acc
+ *
+ *  Otherwise a portable software loop using the hardware multiplier
+ *  is compiled in. Both give bit-identical 32-bit results.
+ * ---------------------------------------------------------------------
+ */
+
+// sum(a[i] * b[i]) for i < n, 32-bit wrap-around accumulation
+alt_32 mac_dot_q15(const alt_16 *a, const alt_16 *b, size_t n);
+
+// Block convolution: out[i] = sat((sum_j h[j] * x[i + j]) >> 15) for
+// i < count, with h the time-reversed taps and x holding taps - 1
+// history samples followed by the count new ones
+void mac_fir_block(const alt_16 *h, size_t taps, const alt_16 *x, alt_16 *out, size_t count);
+
+#endif /* MAC_H_ */
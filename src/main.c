@@ -1,330 +1,540 @@
-#include "altera_avalon_sierra_ker.h"
-#include <altera_avalon_sierra_io.h>
-#include <altera_avalon_sierra_regs.h>
-#include <altera_avalon_sierra_name.h>
-#include <altera_avalon_timer_regs.h>
-#include <altera_avalon_pio_regs.h>
-#include "system.h"
-#include "stdio.h"
-#include "io.h"
-#include <DE10_Lite_VGA_Driver.h>
-#include <DE10_Lite_Arduino_Driver.h>
-#include <alt_types.h>
-#include <stdbool.h>
-
-/*
- * ---------------------------------------------------------------------
- *  RTK MULTITASKING PROJECT
- * ---------------------------------------------------------------------
- *  This system runs multiple periodic tasks using the Sierra RTK kernel:
- *   - Idle task (background)
- *   - Timer task (1Hz counter)
- *   - Accelerometer sampling task
- *   - Accelerometer filtering (average of last 10 samples)
- *   - Plotting task for graphing Z-axis acceleration
- *
- *  Each task runs with its own stack and priority.
- *  The accelerometer values are shared using a RTK semaphore.
- *  All graphical output is rendered on the DE10-Lite VGA framebuffer.
- * ---------------------------------------------------------------------
- */
-
-#define STACK_SIZE 800          // Stack size for each task
-#define SEM_SHARED_DATA 1       // Semaphore ID used for shared accelerometer data
-
-// Task identifiers
-#define IDLE            0
-#define TASK_ACC        2
-#define TASK_ACC_FILTER 3
-#define TASK_TIMER      1
-#define TASK_PLOT       4
-
-// Structure for accelerometer samples
-typedef struct position {
-    int16_t x;
-    int16_t y;
-    int16_t z;
-} position_t;
-
-// Global shared accelerometer data (protected by semaphore)
-position_t global_acc_data;
-
-// Task stacks
-char idle_stack[STACK_SIZE];
-char acc_stack[STACK_SIZE];
-char acc_filter_stack[STACK_SIZE];
-char timer_stack[STACK_SIZE];
-char plot_stack[STACK_SIZE];
-
-// Forward declaration
-void clear_screen_range(size_t start_x, size_t start_y, size_t end_x, size_t end_y);
-
-/* ================================================================
- *                         IDLE TASK
- * ================================================================ */
-void idle_code(void)
-{
-    int i = 0;
-    printf("Idle task started\n");
-
-    while (1)
-    {
-        for (i = 0; i < 500000; i++);  // Cheap delay
-        printf(".\n");
-    }
-}
-
-/* ================================================================
- *                         TIMER TASK
- *  Counts seconds and displays the running time on the screen.
- * ================================================================ */
-void timer_task_code(void)
-{
-    task_periodic_start_union deadline;
-    init_period_time(50);  // 1 second (50 ticks @ 20ms each)
-    const char task_name[] = "Timer";
-
-    unsigned int time = 0;
-
-    while (1)
-    {
-        deadline = wait_for_next_period();
-
-        if (deadline.periodic_start_integer & 0x1)
-            printf("Deadline miss: TIMER task\n");
-
-        time++; // Count seconds
-
-        // Display on screen
-        tty_print(70, 140, task_name, Col_White, Col_Black);
-        int_print(70, 165, time, 5, Col_White, Col_Black);
-    }
-}
-
-/* ================================================================
- *                    ACCELEROMETER READING TASK
- *  Reads new accelerometer samples every second and displays them.
- * ================================================================ */
-void task_acc_code()
-{
-    task_periodic_start_union deadline;
-    init_period_time(50); // 1 second
-
-    position_t local_acc_data;
-
-    while (1)
-    {
-        deadline = wait_for_next_period();
-
-        if (deadline.periodic_start_integer & 0x1)
-            printf("Deadline miss: ACC task\n");
-
-        // Read hardware accelerometer
-        accelerometer_receive(&local_acc_data.x,
-                              &local_acc_data.y,
-                              &local_acc_data.z);
-
-        // Update global shared data
-        sem_take(SEM_SHARED_DATA);
-        global_acc_data = local_acc_data;
-        sem_release(SEM_SHARED_DATA);
-
-        // Display values
-        tty_print(60, 25, "task_Acc", Col_White, Col_Black);
-
-        tty_print(60, 40, "X", Col_White, Col_Black);
-        int_print(70, 40, local_acc_data.x, 3, Col_White, Col_Black);
-
-        tty_print(60, 50, "Y", Col_White, Col_Black);
-        int_print(70, 50, local_acc_data.y, 3, Col_White, Col_Black);
-
-        tty_print(60, 60, "Z", Col_White, Col_Black);
-        int_print(70, 60, local_acc_data.z, 3, Col_White, Col_Black);
-    }
-}
-
-/* ================================================================
- *                ACCELEROMETER FILTER TASK
- *  Computes the average of the last 10 accelerometer samples.
- * ================================================================ */
-void task_acc_filter_code()
-{
-    task_periodic_start_union deadline;
-    init_period_time(50);  // 1 second
-
-    position_t acc_array[10];
-    int counter = 0;
-    bool sampled_ten_times = false;
-
-    int avg_x = 0;
-    int avg_y = 0;
-    int avg_z = 0;
-
-    while (1)
-    {
-        deadline = wait_for_next_period();
-
-        if (deadline.periodic_start_integer & 0x1)
-            printf("Deadline miss: ACC FILTER task\n");
-
-        // Read shared data
-        sem_take(SEM_SHARED_DATA);
-        acc_array[counter] = global_acc_data;
-        sem_release(SEM_SHARED_DATA);
-
-        tty_print(200, 35, "task_acc_filter", Col_White, Col_Black);
-
-        if (sampled_ten_times)
-        {
-            // Reset averages
-            avg_x = avg_y = avg_z = 0;
-
-            for (size_t i = 0; i < 10; i++)
-            {
-                avg_x += acc_array[i].x;
-                avg_y += acc_array[i].y;
-                avg_z += acc_array[i].z;
-            }
-
-            avg_x /= 10;
-            avg_y /= 10;
-            avg_z /= 10;
-
-            // Display filtered output
-            tty_print(220, 50, "X", Col_White, Col_Black);
-            int_print(230, 50, avg_x, 3, Col_White, Col_Black);
-
-            tty_print(220, 60, "Y", Col_White, Col_Black);
-            int_print(230, 60, avg_y, 3, Col_White, Col_Black);
-
-            tty_print(220, 70, "Z", Col_White, Col_Black);
-            int_print(230, 70, avg_z, 3, Col_White, Col_Black);
-        }
-        else if (counter == 9)
-        {
-            sampled_ten_times = true;
-            clear_screen_range(170, 0, 319, 110);
-        }
-        else
-        {
-            tty_print(200, 65, "sampling...", Col_White, Col_Black);
-        }
-
-        counter = (counter + 1) % 10;
-    }
-}
-
-/* ================================================================
- *                       PLOTTING TASK
- *  Plots Z-axis acceleration as a scrolling graph.
- * ================================================================ */
-void task_plot_code()
-{
-    task_periodic_start_union deadline;
-    init_period_time(50);  // 1 second
-
-    position_t local_pos;
-    int counter = 0;
-
-    while (1)
-    {
-        deadline = wait_for_next_period();
-
-        if (deadline.periodic_start_integer & 0x1)
-            printf("Deadline miss: PLOT task\n");
-
-        // Clear part of graph area when starting a new row
-        if (counter == 0)
-            clear_screen_range(170, 125, 319, 239);
-
-        tty_print(200, 130, "task_acc_filter", Col_White, Col_Black);
-
-        // Get accelerometer sample
-        sem_take(SEM_SHARED_DATA);
-        local_pos = global_acc_data;
-        sem_release(SEM_SHARED_DATA);
-
-        // Draw X-axis baseline
-        tty_print(190, 180, "0", Col_White, Col_Black);
-        draw_hline(200, 180, 60, Col_Cyan);
-
-        // Plot Z value
-        draw_filled_circle(
-            205 + (5 * counter),
-            180 + ((local_pos.z / 8) * (-1)),
-            1,
-            Col_Green);
-
-        counter = (counter + 1) % 5;
-    }
-}
-
-/* ================================================================
- *                           MAIN
- * ================================================================ */
-int main()
-{
-    // Initial welcome screen
-    clear_screen(Col_Black);
-    tty_print(150, 20, "Menyar Hees", Col_Magenta, Col_Black);
-    tty_print(140, 120, "press any button", Col_Red, Col_Black);
-
-    int button = 3;
-
-    // Wait for pushbutton input
-    while (button == 3)
-    {
-        button = 0x3 & IORD_ALTERA_AVALON_PIO_DATA(PIO_BUTTONS_IN_BASE);
-    }
-
-    clear_screen(Col_Black);
-
-    // Sierra initialization
-    Sierra_Initiation_HW_and_SW();
-
-    printf("Sierra HW version = %d\n", sierra_HW_version());
-    printf("Sierra SW driver version = %d\n", sierra_SW_driver_version());
-
-    // Set RTK time base: 20ms tick (50Hz)
-    set_timebase(1000);
-
-    // Ensure accelerometer is ready
-    while (!accelerometer_open_dev())
-        printf("Unable to open accelerometer device!\n");
-
-    while (!accelerometer_init())
-        printf("Unable to initialize accelerometer!\n");
-
-    // Draw graph axes
-    draw_hline(0, 120, CANVAS_WIDTH - 1, Col_White);
-    draw_vline(160, 0, CANVAS_HEIGHT - 1, Col_White);
-
-    // Create RTK tasks
-    task_create(IDLE, 0, READY_TASK_STATE, idle_code, idle_stack, STACK_SIZE);
-    task_create(TASK_TIMER, 1, READY_TASK_STATE, timer_task_code, timer_stack, STACK_SIZE);
-    task_create(TASK_ACC, 1, READY_TASK_STATE, task_acc_code, acc_stack, STACK_SIZE);
-    task_create(TASK_ACC_FILTER, 1, READY_TASK_STATE, task_acc_filter_code, acc_filter_stack, STACK_SIZE);
-    task_create(TASK_PLOT, 1, READY_TASK_STATE, task_plot_code, plot_stack, STACK_SIZE);
-
-    // Start multitasking
-    tsw_on();
-
-    while (1)
-        printf("Something went wrong!\n");
-
-    return 0;
-}
-
-/* ================================================================
- *      CLEAR A RECTANGLE AREA OF THE SCREEN (FILL BLACK)
- * ================================================================ */
-void clear_screen_range(size_t start_x, size_t start_y, size_t end_x, size_t end_y)
-{
-    for (size_t x = start_x; x <= end_x; x++)
-    {
-        for (size_t y = start_y; y <= end_y; y++)
-        {
-            write_pixel(x, y, Col_Black);
-        }
-    }
-}
+#include "altera_avalon_sierra_ker.h"
+#include <altera_avalon_sierra_io.h>
+#include <altera_avalon_sierra_regs.h>
+#include <altera_avalon_sierra_name.h>
+#include <altera_avalon_timer_regs.h>
+#include <altera_avalon_pio_regs.h>
+#include "system.h"
+#include "stdio.h"
+#include "io.h"
+#include <DE10_Lite_VGA_Driver.h>
+#include <DE10_Lite_Arduino_Driver.h>
+#include <alt_types.h>
+#include <stdbool.h>
+#include <sys/alt_timestamp.h>
+#include <unistd.h>
+#include "acc_filter.h"
+#include "acc_irq.h"
+#include "adxl345.h"
+#include "analytics.h"
+#include "bench.h"
+#include "dma.h"
+#include "app_config.h"
+#include "compositor.h"
+#include "gfx.h"
+#include "hot.h"
+#include "idle.h"
+#include "log.h"
+#include "moving_average.h"
+#include "position.h"
+#include "render.h"
+#include "sample_ring.h"
+#include "seqlock.h"
+#include "spectrum.h"
+#include "strip_chart.h"
+#include "task_stats.h"
+#include "tasks.h"
+#include "trace.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  RTK MULTITASKING PROJECT
+ * ---------------------------------------------------------------------
+ *  This system runs multiple periodic tasks using the Sierra RTK kernel:
+ *   - Idle task (background work and CPU-load measurement, idle.c)
+ *   - Timer task (1Hz counter)
+ *   - Accelerometer sampling task (drains the ADXL345 FIFO)
+ *   - Accelerometer filtering (DSP chain, moving average and motion
+ *     analytics)
+ *   - Plotting task for graphing Z-axis acceleration
+ *   - Render task (only task that draws on the screen)
+ *
+ *  Each task runs with its own stack; periods, budgets and stacks are
+ *  declared in the task table (tasks.h) and priorities are assigned
+ *  rate-monotonically from the periods.
+ *  Periodic tasks record their timing in task_stats and their
+ *  scheduling events in a trace ring; the push buttons dump either
+ *  to the JTAG UART. Tasks never print directly: LOG() messages are
+ *  queued and printed by the idle task.
+ *  Samples are timestamped into a ring that every consumer reads with
+ *  its own cursor; the latest sample and the motion analytics are
+ *  also published through lock-free seqlocks.
+ *  Tasks queue draw commands; the render task draws them
+ *  on the DE10-Lite VGA framebuffer, either directly or through an
+ *  off-screen back buffer (VGA_DOUBLE_BUFFER).
+ * ---------------------------------------------------------------------
+ */
+
+// Latest accelerometer sample (written by task_acc_code only)
+SEQLOCK(position_t) global_acc_data HOT_DATA;
+
+// The accelerometer was brought up at boot
+static bool acc_ready;
+
+/* ================================================================
+ *                         TIMER TASK
+ *  Counts seconds and displays the running time on the screen.
+ * ================================================================ */
+void timer_task_code(void)
+{
+    static task_stats_t stats;
+    init_period_time(TIMER_PERIOD_TICKS);
+    task_stats_init(&stats, "TIMER", TIMER_PERIOD_TICKS);
+    static const char task_name[] = "Timer";  // Queued by pointer
+    static gfx_field_t time_field;
+
+    unsigned int time = 0;
+
+    // The label never changes; the counter only repaints its changed digits
+    gfx_field_init(&time_field, 70, 165, 5, Col_White, Col_Black);
+    render_text(PANEL_TIMER, 70, 140, task_name, Col_White, Col_Black);
+
+    while (1)
+    {
+        task_stats_wait(&stats);
+
+        time++; // Count seconds
+
+        render_field(PANEL_TIMER, &time_field, time);
+    }
+}
+
+/* ================================================================
+ *                    ACCELEROMETER READING TASK
+ *  Drains the ADXL345 FIFO (one burst read per entry) into the
+ *  sample ring and displays the newest sample about once per second.
+ *  Runs every period, or with ACC_INT_PIO_BASE as the bottom half of
+ *  the FIFO watermark interrupt (acc_irq.h). With ACC_EVENTS it also
+ *  releases the filter and plotting tasks.
+ * ================================================================ */
+#if ACC_EVENTS
+// Release a consumer once threshold samples arrived since its last
+// release. Releases it has not taken yet collapse into one, which is
+// enough: every job drains the ring up to the head.
+static HOT_CODE void acc_event_post(alt_u8 task, size_t *pending, size_t read,
+                                    size_t threshold, int sem)
+{
+    *pending += read;
+
+    if (*pending >= threshold)
+    {
+        *pending = 0;
+        trace_sem_release(task, sem);
+    }
+}
+#endif
+
+HOT_CODE void task_acc_code()
+{
+    static task_stats_t stats;
+    const alt_u32 sample_ticks = alt_timestamp_freq() / ACC_ODR_HZ;
+    static position_t fifo[ADXL345_FIFO_DEPTH] HOT_DATA;
+    acc_sample_t sample;
+    unsigned int periods = 0;
+    bool have_sample = false;
+#if ACC_EVENTS
+    size_t filter_pending = 0, plot_pending = 0;
+#endif
+    alt_u32 anchor;         // Timestamp of FIFO entry anchor_index
+    alt_32 anchor_index;
+    static gfx_field_t acc_fields[3];
+
+    // Boot gave up on the sensor: stay blocked, the other tasks run on
+    if (!acc_ready)
+    {
+        LOG("Accelerometer unavailable: no samples\n");
+
+        while (1)
+            trace_sem_take(TRACE_TASK_UNKNOWN, SEM_ACC_DATA);   // Never released without a sensor
+    }
+
+    render_text(PANEL_ACC, 60, 25, "task_Acc", Col_White, Col_Black);
+    render_text(PANEL_ACC, 60, 40, "X", Col_White, Col_Black);
+    render_text(PANEL_ACC, 60, 50, "Y", Col_White, Col_Black);
+    render_text(PANEL_ACC, 60, 60, "Z", Col_White, Col_Black);
+
+    for (size_t i = 0; i < 3; i++)
+        gfx_field_init(&acc_fields[i], 70, 40 + 10 * i, 3, Col_White, Col_Black);
+
+#ifdef ACC_INT_PIO_BASE
+    task_stats_init(&stats, "ACC", 0);
+
+    // Start from an empty FIFO so INT1 produces a fresh edge
+    adxl345_read_fifo(fifo, ADXL345_FIFO_DEPTH);
+    acc_irq_rearm();
+#else
+    init_period_time(ACC_PERIOD_TICKS);
+    task_stats_init(&stats, "ACC", ACC_PERIOD_TICKS);
+#endif
+
+    while (1)
+    {
+#ifdef ACC_INT_PIO_BASE
+        task_stats_wait_sem(&stats, SEM_ACC_DATA);
+
+        if (!acc_irq_fetch(&anchor))
+            continue;
+
+        // The interrupt fired when the watermark entry was written;
+        // later entries follow one output-data-rate period apart
+        anchor_index = ACC_FIFO_WATERMARK - 1;
+        size_t read = adxl345_read_fifo(fifo, ADXL345_FIFO_DEPTH);
+        acc_irq_rearm();
+#else
+        task_stats_wait(&stats);
+
+        // The newest FIFO entry was captured about now; older entries
+        // are spaced one output-data-rate period apart
+        anchor = alt_timestamp();
+        size_t read = adxl345_read_fifo(fifo, ADXL345_FIFO_DEPTH);
+        anchor_index = (alt_32)read - 1;
+#endif
+
+        for (size_t i = 0; i < read; i++)
+        {
+            sample.pos = fifo[i];
+            sample.timestamp = anchor + ((alt_32)i - anchor_index) * (alt_32)sample_ticks;
+            sample_ring_push(&acc_ring, &sample);
+        }
+
+#if ACC_EVENTS
+        acc_event_post(stats.id, &filter_pending, read, FILTER_EVENT_SAMPLES, SEM_FILTER_DATA);
+        acc_event_post(stats.id, &plot_pending, read, PLOT_EVENT_SAMPLES, SEM_PLOT_DATA);
+#endif
+
+        if (read > 0)
+        {
+            seqlock_write(&global_acc_data, sample.pos);
+            have_sample = true;
+        }
+
+        if (++periods < ACC_DISPLAY_PERIODS || !have_sample)
+            continue;
+
+        periods = 0;
+
+        // Display values
+        render_field(PANEL_ACC, &acc_fields[0], sample.pos.x);
+        render_field(PANEL_ACC, &acc_fields[1], sample.pos.y);
+        render_field(PANEL_ACC, &acc_fields[2], sample.pos.z);
+    }
+}
+
+/* ================================================================
+ *                ACCELEROMETER FILTER TASK
+ *  Runs every new sample through the fixed-point filter chain and
+ *  shows the moving average of its output. Runs every period, or with
+ *  ACC_EVENTS whenever FILTER_EVENT_SAMPLES new samples are ready.
+ * ================================================================ */
+HOT_CODE void task_acc_filter_code()
+{
+    static task_stats_t stats;
+#if ACC_EVENTS
+    task_stats_init(&stats, "ACC_FILTER", 0);
+#else
+    init_period_time(ACC_FILTER_PERIOD_TICKS);
+    task_stats_init(&stats, "ACC_FILTER", ACC_FILTER_PERIOD_TICKS);
+#endif
+
+    // One array per axis; word aligned for the two-samples-per-word
+    // input scaling
+    static alt_16 raw[AXIS_COUNT][FILTER_BLOCK] HOT_DATA __attribute__((aligned(4)));
+    static alt_16 filtered[AXIS_COUNT][FILTER_BLOCK] HOT_DATA;
+    static ma_xyz_t average HOT_DATA;
+    static gfx_field_t filter_fields[3];
+    sample_cursor_t cursor;
+    bool window_full = false;
+    alt_32 avg_x, avg_y, avg_z;
+    size_t count;
+
+    sample_cursor_init(&acc_ring, &cursor);
+    acc_filter_init();
+    analytics_init();
+    ma_xyz_init(&average);
+
+    for (size_t i = 0; i < 3; i++)
+        gfx_field_init(&filter_fields[i], 230, 50 + 10 * i, 3, Col_White, Col_Black);
+
+    render_text(PANEL_FILTER, 200, 35, "task_acc_filter", Col_White, Col_Black);
+
+    while (1)
+    {
+#if ACC_EVENTS
+        task_stats_wait_sem(&stats, SEM_FILTER_DATA);
+#else
+        task_stats_wait(&stats);
+#endif
+
+        // Consume every sample produced since the last job
+        while ((count = sample_ring_read_axes(&acc_ring, &cursor, raw[AXIS_X], raw[AXIS_Y],
+                                              raw[AXIS_Z], FILTER_BLOCK)) > 0)
+        {
+            analytics_process(raw, count);
+
+            // Block through the DSP chain, then the display average
+            count = acc_filter_process(raw, count, filtered);
+            ma_xyz_push_block(&average, filtered[AXIS_X], filtered[AXIS_Y], filtered[AXIS_Z], count);
+        }
+
+        if (!window_full && ma_xyz_full(&average))
+        {
+            window_full = true;
+            render_flush(PANEL_FILTER);  // Erase "sampling..."
+
+            // The axis labels overlap "sampling...": draw them once now
+            render_text(PANEL_FILTER, 220, 50, "X", Col_White, Col_Black);
+            render_text(PANEL_FILTER, 220, 60, "Y", Col_White, Col_Black);
+            render_text(PANEL_FILTER, 220, 70, "Z", Col_White, Col_Black);
+        }
+
+        if (window_full)
+        {
+            // Display filtered output
+            ma_xyz_value(&average, &avg_x, &avg_y, &avg_z);
+            render_field(PANEL_FILTER, &filter_fields[0], ma_to_int(avg_x));
+            render_field(PANEL_FILTER, &filter_fields[1], ma_to_int(avg_y));
+            render_field(PANEL_FILTER, &filter_fields[2], ma_to_int(avg_z));
+        }
+        else
+        {
+            render_text_transient(PANEL_FILTER, 200, 65, "sampling...", Col_White, Col_Black);
+        }
+    }
+}
+
+/* ================================================================
+ *                       PLOTTING TASK
+ *  Plots Z-axis acceleration as a sweeping strip chart: one new
+ *  column per period, only the oldest column is repainted. With
+ *  ACC_EVENTS one column per PLOT_EVENT_SAMPLES samples instead,
+ *  drawn when the acquisition task releases the task. With SPECTRUM
+ *  the panel shows the bars of the spectrum task instead.
+ * ================================================================ */
+#if SPECTRUM
+// Redraws a few changed bars per job; the bars span the chart's columns
+static void plot_spectrum(task_stats_t *stats)
+{
+    static spectrum_view_t view;
+
+    spectrum_view_init(&view, PANEL_PLOT, 170, STRIP_CHART_MAX_WIDTH, 239, Col_Green, Col_Black);
+    render_text(PANEL_PLOT, 168, 130, "spectrum 0..", Col_White, Col_Black);
+    render_int(PANEL_PLOT, 264, 130, ACC_ODR_HZ / 2, 4, Col_White, Col_Black);
+    render_text(PANEL_PLOT, 304, 130, "Hz", Col_White, Col_Black);
+
+    while (1)
+    {
+#if ACC_EVENTS
+        task_stats_wait_sem(stats, SEM_PLOT_DATA);
+#else
+        task_stats_wait(stats);
+#endif
+        spectrum_view_update(&view);
+    }
+}
+#endif
+
+void task_plot_code()
+{
+    static task_stats_t stats;
+#if ACC_EVENTS
+    task_stats_init(&stats, "PLOT", 0);
+#else
+    init_period_time(PLOT_PERIOD_TICKS);
+    task_stats_init(&stats, "PLOT", PLOT_PERIOD_TICKS);
+#endif
+
+#if SPECTRUM
+    plot_spectrum(&stats);
+#else
+#if ACC_EVENTS
+    size_t pending = 0;
+#else
+    position_t local_pos = { 0, 0, 0 };
+#endif
+    static acc_sample_t batch[FILTER_BLOCK];
+    static strip_chart_t chart;
+    sample_cursor_t cursor;
+    size_t count;
+
+    sample_cursor_init(&acc_ring, &cursor);
+
+    // Static parts are drawn once; the chart covers x = 170..319
+    strip_chart_init(&chart, PANEL_PLOT, 170, STRIP_CHART_MAX_WIDTH, 140, 239, 180,
+                     Col_Green, Col_Cyan, Col_Black);
+    render_text(PANEL_PLOT, 200, 130, "task_acc_filter", Col_White, Col_Black);
+    render_text(PANEL_PLOT, 161, 177, "0", Col_White, Col_Black);
+    strip_chart_draw_frame(&chart);
+
+    while (1)
+    {
+#if ACC_EVENTS
+        task_stats_wait_sem(&stats, SEM_PLOT_DATA);
+
+        // Plot the last sample of every full group of new samples. A
+        // late job can have more groups than the queue has room for
+        // (RENDER_QUEUE_SIZE / STRIP_CHART_PUSH_CMDS columns); the
+        // columns that do not fit are skipped and counted as dropped
+        while ((count = sample_ring_read(&acc_ring, &cursor, batch, FILTER_BLOCK)) > 0)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                if (++pending < PLOT_EVENT_SAMPLES)
+                    continue;
+
+                pending = 0;
+                strip_chart_push(&chart, batch[i].pos.z / (1 << PLOT_SCALE_SHIFT));
+            }
+        }
+#else
+        task_stats_wait(&stats);
+
+        // Plot the newest of the samples produced since the last period
+        while ((count = sample_ring_read(&acc_ring, &cursor, batch, FILTER_BLOCK)) > 0)
+            local_pos = batch[count - 1].pos;
+
+        strip_chart_push(&chart, local_pos.z / (1 << PLOT_SCALE_SHIFT));
+#endif
+    }
+#endif
+}
+
+/* ================================================================
+ *                          START-UP
+ * ================================================================ */
+// Headless when compiled in or selected by the boot switch
+static bool headless_boot(void)
+{
+#ifdef BOOT_SWITCH_PIO_BASE
+    if (IORD_ALTERA_AVALON_PIO_DATA(BOOT_SWITCH_PIO_BASE) & BOOT_SWITCH_MASK)
+        return true;
+#endif
+    return HEADLESS_BOOT;
+}
+
+// One bring-up attempt; returns the step that failed or NULL
+static const char *acc_bring_up(void)
+{
+    if (!accelerometer_open_dev())
+        return "open the device";
+    if (!accelerometer_init())
+        return "initialize it";
+
+    // Run the sensor at its own data rate with the FIFO in stream mode
+    if (!adxl345_open() || !adxl345_configure_stream(ACC_ODR_HZ))
+        return "configure the FIFO";
+
+#ifdef ACC_INT_PIO_BASE
+    if (!acc_irq_init())
+        return "register the interrupt";
+#endif
+
+    return NULL;
+}
+
+// Bounded retries with a doubling wait, one console line per failure
+static bool acc_boot(void)
+{
+    alt_u32 backoff = ACC_BOOT_BACKOFF_US;
+
+    for (int attempt = 1; ; attempt++)
+    {
+        const char *failed = acc_bring_up();
+
+        if (!failed)
+            return true;
+
+        printf("Accelerometer: unable to %s (attempt %d of %d)\n",
+               failed, attempt, ACC_BOOT_ATTEMPTS);
+
+        if (attempt >= ACC_BOOT_ATTEMPTS)
+            return false;
+
+        usleep(backoff);
+        backoff *= 2;
+    }
+}
+
+// Screen background, drawn by the render task before its first job
+static void draw_background(void)
+{
+    gfx_clear(Col_Black);
+    gfx_hline(0, 120, CANVAS_WIDTH - 1, Col_White);
+    gfx_vline(160, 0, CANVAS_HEIGHT - 1, Col_White);
+}
+
+/* ================================================================
+ *                           MAIN
+ * ================================================================ */
+int main()
+{
+    if (!headless_boot())
+    {
+        // Initial welcome screen
+        clear_screen(Col_Black);
+        tty_print(150, 20, "Menyar Hees", Col_Magenta, Col_Black);
+        tty_print(140, 120, "press any button", Col_Red, Col_Black);
+
+        int button = 3;
+
+        // Wait for pushbutton input
+        while (button == 3)
+        {
+            button = 0x3 & IORD_ALTERA_AVALON_PIO_DATA(PIO_BUTTONS_IN_BASE);
+        }
+    }
+
+    // Sierra initialization
+    Sierra_Initiation_HW_and_SW();
+
+    printf("Sierra HW version = %d\n", sierra_HW_version());
+    printf("Sierra SW driver version = %d\n", sierra_SW_driver_version());
+
+    // Set RTK time base: 20ms tick (50Hz)
+    set_timebase(1000);
+
+    acc_ready = acc_boot();
+    if (!acc_ready)
+        printf("Accelerometer unavailable: starting without samples\n");
+
+    if (alt_timestamp_start() < 0)
+        printf("No timestamp timer: sample timestamps are invalid\n");
+
+    sample_ring_init(&acc_ring);
+    mutex_init(&console_mutex, "console", CONSOLE_CS_US);
+
+#ifdef HOST_MSGDMA_NAME
+    if (!dma_host_open())
+        printf("No host DMA: raw samples are not streamed\n");
+#endif
+
+    fb_init();
+    compositor_init();
+
+    // Clear and axes are left to the render task, so the kernel and
+    // the acquisition start without waiting for the screen
+    render_set_background(draw_background);
+
+#if BENCH
+    // Benchmark build: time the primitives instead of running the tasks
+    draw_background();
+    bench_create();
+#else
+    // Create RTK tasks: idle, then the task table in rate-monotonic order
+    tasks_assign_priorities();
+    if (!tasks_schedulable())
+        printf("Warning: task budgets fail the response-time test\n");
+
+    tasks_create(idle_code);
+#endif
+
+    // From here on console output goes through console_printf()
+    console_init();
+
+    // Start multitasking
+    tsw_on();
+
+    while (1)
+        printf("Something went wrong!\n");
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+#include "hot.h"
+#include "moving_average.h"
+
+void ma_init(moving_average_t *ma)
+{
+    ma->sum = 0;
+    ma->index = 0;
+    ma->count = 0;
+
+    for (alt_u32 i = 0; i < MA_WINDOW; i++)
+        ma->history[i] = 0;
+}
+
+// Running sum to average (Q.MA_FRAC_BITS)
+static inline alt_32 scale(alt_32 sum)
+{
+#if MA_WINDOW_LOG2 >= MA_FRAC_BITS
+    return sum >> (MA_WINDOW_LOG2 - MA_FRAC_BITS);
+#else
+    return sum * (1 << (MA_FRAC_BITS - MA_WINDOW_LOG2));
+#endif
+}
+
+alt_32 ma_value(const moving_average_t *ma)
+{
+    return scale(ma->sum);
+}
+
+HOT_CODE alt_32 ma_push(moving_average_t *ma, alt_16 sample)
+{
+    // The history starts zeroed, so subtracting the slot is correct
+    // while the window is still filling
+    ma->sum += sample - ma->history[ma->index];
+    ma->history[ma->index] = sample;
+    ma->index = (ma->index + 1) & MA_MASK;
+
+    if (ma->count < MA_WINDOW)
+        ma->count++;
+
+    return ma_value(ma);
+}
+
+/* ================================================================
+ *                      THREE-AXIS VARIANT
+ * ================================================================ */
+static inline alt_u32 pack_xy(alt_16 x, alt_16 y)
+{
+    return ((alt_u32)(alt_u16)y << 16) + (alt_u32)(alt_32)x;
+}
+
+// Low lane sign-extended, then the high lane without it
+static inline void unpack_xy(alt_u32 xy, alt_32 *x, alt_32 *y)
+{
+    alt_16 low = (alt_16)xy;
+
+    *x = low;
+    *y = (alt_32)(xy - (alt_u32)(alt_32)low) >> 16;
+}
+
+void ma_xyz_init(ma_xyz_t *ma)
+{
+    ma->sum_x = 0;
+    ma->sum_y = 0;
+    ma->sum_z = 0;
+    ma->index = 0;
+    ma->count = 0;
+
+    for (alt_u32 i = 0; i < MA_WINDOW; i++)
+    {
+        ma->history_xy[i] = 0;
+        ma->history_z[i] = 0;
+    }
+}
+
+HOT_CODE void ma_xyz_push_block(ma_xyz_t *ma, const alt_16 *x, const alt_16 *y, const alt_16 *z, size_t count)
+{
+    alt_32 sum_z = ma->sum_z;
+    alt_u32 index = ma->index;
+
+    for (size_t i = 0; i < count; )
+    {
+        size_t end = count - i > MA_XYZ_FLUSH ? i + MA_XYZ_FLUSH : count;
+        alt_u32 change_xy = 0;
+        alt_32 dx, dy;
+
+        for (; i < end; i++)
+        {
+            alt_u32 xy = pack_xy(x[i], y[i]);
+
+            // Wrap-around arithmetic: carries between the lanes cancel out
+            change_xy += xy - ma->history_xy[index];
+            sum_z += z[i] - ma->history_z[index];
+            ma->history_xy[index] = xy;
+            ma->history_z[index] = z[i];
+            index = (index + 1) & MA_MASK;
+        }
+
+        // Widen before a lane could leave the int16 range
+        unpack_xy(change_xy, &dx, &dy);
+        ma->sum_x += dx;
+        ma->sum_y += dy;
+    }
+
+    ma->sum_z = sum_z;
+    ma->index = index;
+    ma->count = ma->count + count < MA_WINDOW ? ma->count + count : MA_WINDOW;
+}
+
+void ma_xyz_value(const ma_xyz_t *ma, alt_32 *x, alt_32 *y, alt_32 *z)
+{
+    *x = scale(ma->sum_x);
+    *y = scale(ma->sum_y);
+    *z = scale(ma->sum_z);
+}
@@ -0,0 +1,98 @@
+#ifndef MOVING_AVERAGE_H_
+#define MOVING_AVERAGE_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <alt_types.h>
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  RUNNING-SUM MOVING AVERAGE
+ * ---------------------------------------------------------------------
+ *  Boxcar average over the last MA_WINDOW samples in constant time per
+ *  sample: the new sample is added to a running sum and the one that
+ *  leaves the window is subtracted. The window is a power of two so
+ *  the division is a shift; the result is fixed-point with
+ *  MA_FRAC_BITS fractional bits.
+ * ---------------------------------------------------------------------
+ */
+
+#define MA_WINDOW (1u << MA_WINDOW_LOG2)
+#define MA_MASK   (MA_WINDOW - 1)
+
+typedef struct moving_average {
+    alt_32 sum;
+    alt_u32 index;              // Slot of the oldest sample
+    alt_u32 count;              // Samples seen, saturates at MA_WINDOW
+    alt_16 history[MA_WINDOW];
+} moving_average_t;
+
+void ma_init(moving_average_t *ma);
+
+// Add a sample and return the new average (Q.MA_FRAC_BITS)
+alt_32 ma_push(moving_average_t *ma, alt_16 sample);
+
+// Current average (Q.MA_FRAC_BITS)
+alt_32 ma_value(const moving_average_t *ma);
+
+// True once the window holds MA_WINDOW samples
+static inline bool ma_full(const moving_average_t *ma)
+{
+    return ma->count == MA_WINDOW;
+}
+
+// Integer part of a Q.MA_FRAC_BITS value, rounded toward zero
+static inline int ma_to_int(alt_32 value)
+{
+    return value < 0 ? -(-value >> MA_FRAC_BITS) : value >> MA_FRAC_BITS;
+}
+
+/*
+ * ---------------------------------------------------------------------
+ *  THREE-AXIS MOVING AVERAGE
+ * ---------------------------------------------------------------------
+ *  Averages x, y and z together. The history keeps x and y packed
+ *  into one 32-bit word as x + y * 65536, so one 32-bit subtract gives
+ *  the change of both lanes (SIMD within a register) and one add
+ *  accumulates it. A lane reads back exactly while its true value fits
+ *  in int16, so the packed sum of changes is widened into 32-bit
+ *  running sums every MA_XYZ_FLUSH samples: samples have at most
+ *  MA_XYZ_SAMPLE_BITS bits (the filter output), and MA_XYZ_FLUSH
+ *  changes of such samples fit a lane. The running sums hold any
+ *  window up to MA_WINDOW_LOG2 = 16. z is not packed.
+ * ---------------------------------------------------------------------
+ */
+
+#define MA_XYZ_SAMPLE_BITS (15 - FILTER_INPUT_SHIFT)
+#define MA_XYZ_FLUSH       (1u << (14 - MA_XYZ_SAMPLE_BITS))
+
+#if FILTER_INPUT_SHIFT < 1
+#error "ma_xyz_t needs FILTER_INPUT_SHIFT >= 1 (one sample change per 16-bit lane)"
+#endif
+
+typedef struct ma_xyz {
+    alt_32 sum_x;               // Running sums
+    alt_32 sum_y;
+    alt_32 sum_z;
+    alt_u32 index;              // Slot of the oldest sample
+    alt_u32 count;              // Samples seen, saturates at MA_WINDOW
+    alt_u32 history_xy[MA_WINDOW];
+    alt_16 history_z[MA_WINDOW];
+} ma_xyz_t;
+
+void ma_xyz_init(ma_xyz_t *ma);
+
+// Add count samples given as one array per axis (|sample| below
+// 1 << MA_XYZ_SAMPLE_BITS)
+void ma_xyz_push_block(ma_xyz_t *ma, const alt_16 *x, const alt_16 *y, const alt_16 *z, size_t count);
+
+// Current averages (Q.MA_FRAC_BITS)
+void ma_xyz_value(const ma_xyz_t *ma, alt_32 *x, alt_32 *y, alt_32 *z);
+
+static inline bool ma_xyz_full(const ma_xyz_t *ma)
+{
+    return ma->count == MA_WINDOW;
+}
+
+#endif /* MOVING_AVERAGE_H_ */
@@ -0,0 +1,63 @@
+#include "altera_avalon_sierra_ker.h"
+#include <sys/alt_timestamp.h>
+#include "log.h"
+#include "mutex.h"
+
+static mutex_t *registry[MUTEX_MAX];
+static size_t registered;
+static unsigned int depth;          // Mutexes held; switching is off while > 0
+
+void mutex_init(mutex_t *mutex, const char *name, alt_u32 bound_us)
+{
+    mutex->name = name;
+    mutex->locked_at = 0;
+    mutex->hold_max = 0;
+    mutex->bound_us = bound_us;
+
+    if (registered < MUTEX_MAX)
+        registry[registered++] = mutex;
+}
+
+/* ================================================================
+ *                      LOCK AND UNLOCK
+ *  Only the outermost section switches the scheduler, so nested
+ *  sections do not turn preemption back on early.
+ * ================================================================ */
+void mutex_lock(mutex_t *mutex)
+{
+    // depth is only non-zero while switching is off, so a task that
+    // preempts this one before tsw_off() leaves it at zero again
+    if (depth == 0)
+        tsw_off();
+    depth++;
+    mutex->locked_at = alt_timestamp();
+}
+
+void mutex_unlock(mutex_t *mutex)
+{
+    alt_u32 held = alt_timestamp() - mutex->locked_at;
+
+    if (held > mutex->hold_max)
+        mutex->hold_max = held;
+
+    if (--depth == 0)
+        tsw_on();
+}
+
+/* ================================================================
+ *                           REPORT
+ * ================================================================ */
+void mutex_report(void)
+{
+    const alt_u32 ticks_per_us = alt_timestamp_freq() / 1000000;
+
+    for (size_t i = 0; i < registered; i++)
+    {
+        // Copied before printing: locking the console updates it
+        alt_u32 hold_us = registry[i]->hold_max / ticks_per_us;
+
+        console_printf("mutex %-10s hold_max %6lu us (bound %lu us)%s\n", registry[i]->name,
+                       (unsigned long)hold_us, (unsigned long)registry[i]->bound_us,
+                       hold_us > registry[i]->bound_us ? "  OVER" : "");
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef MUTEX_H_
+#define MUTEX_H_
+
+#include <alt_types.h>
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  MUTEXES (IMMEDIATE PRIORITY CEILING)
+ * ---------------------------------------------------------------------
+ *  A Sierra semaphore has no owner, so a low-priority holder can be
+ *  preempted by any number of medium-priority jobs while a high-priority
+ *  task waits for it: the inversion is unbounded. Sierra cannot change
+ *  a task's priority either, so there is no inheritance to build on.
+ *  A mutex here uses the one ceiling the kernel offers: mutex_lock()
+ *  turns task switching off and mutex_unlock() turns it back on. The
+ *  holder runs above every task until it unlocks, and nobody ever
+ *  waits on a mutex.
+ *
+ *  As with any ceiling protocol, a job is blocked at most once, before
+ *  it starts, by one critical section of a lower-priority task. The
+ *  response-time analysis in tasks.c adds the longest such section as
+ *  blocking time: the cs column of the task table, IDLE_CS_US for the
+ *  idle task. Every mutex is registered with the section length the
+ *  analysis assumes for it; mutex_report() prints the longest hold
+ *  measured and flags any mutex held longer than that.
+ *
+ *  Keep sections short and never wait inside one (sem_take(),
+ *  task_stats_wait(), blocking device reads). Interrupts stay enabled.
+ *  Sections of different mutexes may nest; a mutex must not be locked
+ *  again by its holder.
+ * ---------------------------------------------------------------------
+ */
+
+typedef struct mutex {
+    const char *name;
+    alt_u32 locked_at;      // alt_timestamp() of the current lock
+    alt_u32 hold_max;       // Longest hold in timestamp ticks
+    alt_u32 bound_us;       // Longest section the analysis assumes
+} mutex_t;
+
+// Register a mutex for mutex_report() (before tsw_on())
+void mutex_init(mutex_t *mutex, const char *name, alt_u32 bound_us);
+
+void mutex_lock(mutex_t *mutex);
+void mutex_unlock(mutex_t *mutex);
+
+// Print the longest hold of every mutex against its bound (microseconds)
+void mutex_report(void);
+
+#endif /* MUTEX_H_ */
@@ -0,0 +1,27 @@
+#ifndef POSITION_H_
+#define POSITION_H_
+
+#include <alt_types.h>
+
+// Structure for accelerometer samples
+typedef struct position {
+    int16_t x;
+    int16_t y;
+    int16_t z;
+} position_t;
+
+// Sample with its capture time (alt_timestamp() ticks)
+typedef struct acc_sample {
+    alt_u32 timestamp;
+    position_t pos;
+} acc_sample_t;
+
+// Axis index for structure-of-arrays blocks (one array per axis)
+typedef enum {
+    AXIS_X = 0,
+    AXIS_Y,
+    AXIS_Z,
+    AXIS_COUNT
+} axis_t;
+
+#endif /* POSITION_H_ */
@@ -0,0 +1,301 @@
+#include "altera_avalon_sierra_ker.h"
+#include <alt_types.h>
+#include "app_config.h"
+#include "barrier.h"
+#include "gfx.h"
+#include "log.h"
+#include "render.h"
+#include "task_stats.h"
+
+#define RENDER_QUEUE_MASK (RENDER_QUEUE_SIZE - 1)
+
+#if (RENDER_QUEUE_SIZE & RENDER_QUEUE_MASK) != 0
+#error "RENDER_QUEUE_SIZE must be a power of two"
+#endif
+
+typedef enum {
+    DRAW_TEXT = 0,
+    DRAW_TEXT_TRANSIENT,
+    DRAW_INT,
+    DRAW_FIELD,
+    DRAW_HLINE,
+    DRAW_VLINE,
+    DRAW_FILL_RECT,
+    DRAW_CIRCLE,
+    DRAW_FLUSH
+} draw_op_t;
+
+// One queued draw command (16 bytes)
+typedef struct draw_cmd {
+    alt_u8  op;
+    alt_u8  digits;
+    alt_u16 x;
+    alt_u16 y;
+    alt_u16 color;      // Foreground / line colour
+    union {
+        struct {
+            const char *text;
+            alt_u16 bg;
+        } text;
+        struct {
+            alt_32 value;
+            alt_u16 bg;
+        } num;
+        struct {
+            gfx_field_t *field;
+            alt_32 value;
+        } field;
+        struct {
+            alt_u16 x1;     // Far corner, line length or radius
+            alt_u16 y1;
+        } geom;
+    } u;
+} draw_cmd_t;
+
+// SPSC ring: only the owning task writes head, only the render task
+// writes tail
+typedef struct draw_queue {
+    volatile alt_u32 head;
+    volatile alt_u32 tail;
+    unsigned int dropped;
+    draw_cmd_t cmds[RENDER_QUEUE_SIZE];
+} draw_queue_t;
+
+static draw_queue_t queues[PANEL_COUNT];
+
+/* ================================================================
+ *                      PRODUCER SIDE
+ * ================================================================ */
+static draw_cmd_t *queue_reserve(panel_id_t panel)
+{
+    draw_queue_t *q = &queues[panel];
+
+    if (q->head - q->tail >= RENDER_QUEUE_SIZE)
+    {
+        q->dropped++;
+        return NULL;
+    }
+
+    return &q->cmds[q->head & RENDER_QUEUE_MASK];
+}
+
+bool render_reserve(panel_id_t panel, size_t commands)
+{
+    draw_queue_t *q = &queues[panel];
+
+    // The consumer only ever frees slots, so the room seen here stays
+    if (q->head - q->tail + commands <= RENDER_QUEUE_SIZE)
+        return true;
+
+    q->dropped += commands;
+    return false;
+}
+
+static void queue_publish(panel_id_t panel)
+{
+    compiler_barrier();     // Command body before the new head
+    queues[panel].head++;
+}
+
+static bool push_text(panel_id_t panel, draw_op_t op, size_t x, size_t y, const char *text, vga_color_t fg, vga_color_t bg)
+{
+    draw_cmd_t *cmd = queue_reserve(panel);
+
+    if (!cmd)
+        return false;
+
+    cmd->op = op;
+    cmd->x = x;
+    cmd->y = y;
+    cmd->color = fg;
+    cmd->u.text.text = text;
+    cmd->u.text.bg = bg;
+    queue_publish(panel);
+    return true;
+}
+
+static bool push_geom(panel_id_t panel, draw_op_t op, size_t x, size_t y, size_t x1, size_t y1, vga_color_t color)
+{
+    draw_cmd_t *cmd = queue_reserve(panel);
+
+    if (!cmd)
+        return false;
+
+    cmd->op = op;
+    cmd->x = x;
+    cmd->y = y;
+    cmd->color = color;
+    cmd->u.geom.x1 = x1;
+    cmd->u.geom.y1 = y1;
+    queue_publish(panel);
+    return true;
+}
+
+bool render_text(panel_id_t panel, size_t x, size_t y, const char *text, vga_color_t fg, vga_color_t bg)
+{
+    return push_text(panel, DRAW_TEXT, x, y, text, fg, bg);
+}
+
+bool render_text_transient(panel_id_t panel, size_t x, size_t y, const char *text, vga_color_t fg, vga_color_t bg)
+{
+    return push_text(panel, DRAW_TEXT_TRANSIENT, x, y, text, fg, bg);
+}
+
+bool render_int(panel_id_t panel, size_t x, size_t y, int value, size_t digits, vga_color_t fg, vga_color_t bg)
+{
+    draw_cmd_t *cmd = queue_reserve(panel);
+
+    if (!cmd)
+        return false;
+
+    cmd->op = DRAW_INT;
+    cmd->digits = digits;
+    cmd->x = x;
+    cmd->y = y;
+    cmd->color = fg;
+    cmd->u.num.value = value;
+    cmd->u.num.bg = bg;
+    queue_publish(panel);
+    return true;
+}
+
+bool render_field(panel_id_t panel, gfx_field_t *field, int value)
+{
+    draw_cmd_t *cmd = queue_reserve(panel);
+
+    if (!cmd)
+        return false;
+
+    cmd->op = DRAW_FIELD;
+    cmd->u.field.field = field;
+    cmd->u.field.value = value;
+    queue_publish(panel);
+    return true;
+}
+
+bool render_hline(panel_id_t panel, size_t x, size_t y, size_t length, vga_color_t color)
+{
+    return push_geom(panel, DRAW_HLINE, x, y, length, 0, color);
+}
+
+bool render_vline(panel_id_t panel, size_t x, size_t y, size_t length, vga_color_t color)
+{
+    return push_geom(panel, DRAW_VLINE, x, y, length, 0, color);
+}
+
+bool render_fill_rect(panel_id_t panel, size_t x0, size_t y0, size_t x1, size_t y1, vga_color_t color)
+{
+    return push_geom(panel, DRAW_FILL_RECT, x0, y0, x1, y1, color);
+}
+
+bool render_circle(panel_id_t panel, size_t x, size_t y, size_t radius, vga_color_t color)
+{
+    return push_geom(panel, DRAW_CIRCLE, x, y, radius, 0, color);
+}
+
+bool render_flush(panel_id_t panel)
+{
+    return push_geom(panel, DRAW_FLUSH, 0, 0, 0, 0, 0);
+}
+
+unsigned int render_dropped(panel_id_t panel)
+{
+    return queues[panel].dropped;
+}
+
+void render_report(void)
+{
+    console_printf("render dropped: acc %u filter %u timer %u plot %u commands\n",
+                   render_dropped(PANEL_ACC), render_dropped(PANEL_FILTER),
+                   render_dropped(PANEL_TIMER), render_dropped(PANEL_PLOT));
+}
+
+/* ================================================================
+ *                      CONSUMER SIDE
+ * ================================================================ */
+static void execute(panel_id_t panel, const draw_cmd_t *cmd)
+{
+    switch (cmd->op)
+    {
+    case DRAW_TEXT:
+        gfx_text(cmd->x, cmd->y, cmd->u.text.text, cmd->color, cmd->u.text.bg);
+        break;
+    case DRAW_TEXT_TRANSIENT:
+        comp_text(panel, cmd->x, cmd->y, cmd->u.text.text, cmd->color, cmd->u.text.bg);
+        break;
+    case DRAW_INT:
+        gfx_int(cmd->x, cmd->y, cmd->u.num.value, cmd->digits, cmd->color, cmd->u.num.bg);
+        break;
+    case DRAW_FIELD:
+        gfx_field_draw(cmd->u.field.field, cmd->u.field.value);
+        break;
+    case DRAW_HLINE:
+        gfx_hline(cmd->x, cmd->y, cmd->u.geom.x1, cmd->color);
+        break;
+    case DRAW_VLINE:
+        gfx_vline(cmd->x, cmd->y, cmd->u.geom.x1, cmd->color);
+        break;
+    case DRAW_FILL_RECT:
+        fb_fill_rect(cmd->x, cmd->y, cmd->u.geom.x1, cmd->u.geom.y1, cmd->color);
+        break;
+    case DRAW_CIRCLE:
+        comp_circle(panel, cmd->x, cmd->y, cmd->u.geom.x1, cmd->color);
+        break;
+    case DRAW_FLUSH:
+        compositor_flush(panel);
+        break;
+    default:
+        break;
+    }
+}
+
+void render_drain(void)
+{
+    for (size_t p = 0; p < PANEL_COUNT; p++)
+    {
+        draw_queue_t *q = &queues[p];
+        alt_u32 head = q->head;
+
+        compiler_barrier();     // Read head before the commands it covers
+
+        while (q->tail != head)
+        {
+            execute((panel_id_t)p, &q->cmds[q->tail & RENDER_QUEUE_MASK]);
+            compiler_barrier();
+            q->tail++;
+        }
+    }
+
+    fb_present();
+}
+
+/* ================================================================
+ *                         RENDER TASK
+ *  Drains the draw queues of every panel (priority from tasks.h).
+ * ================================================================ */
+static void (*background)(void);
+
+void render_set_background(void (*draw)(void))
+{
+    background = draw;
+}
+
+void render_task_code(void)
+{
+    static task_stats_t stats;
+
+    // Outside the timed jobs: a full-screen clear is a one-off, and
+    // the higher-priority tasks preempt it like any other job
+    if (background)
+        background();
+
+    init_period_time(RENDER_PERIOD_TICKS);
+    task_stats_init(&stats, "RENDER", RENDER_PERIOD_TICKS);
+
+    while (1)
+    {
+        task_stats_wait(&stats);
+
+        render_drain();
+    }
+}
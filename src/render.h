@@ -0,0 +1,66 @@
+#ifndef RENDER_H_
+#define RENDER_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "compositor.h"
+#include "gfx.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  RENDER TASK AND DRAW-COMMAND QUEUES
+ * ---------------------------------------------------------------------
+ *  Tasks no longer touch the framebuffer. The render_* calls append a
+ *  draw command to the single-producer/single-consumer queue of the
+ *  caller's panel in O(1) and return; the render task
+ *  drains all queues and is the only code that draws after start-up.
+ *
+ *  Each panel must be fed by exactly one task. Text passed to
+ *  render_text() is stored by pointer and must outlive the command
+ *  (string literals or static buffers).
+ *
+ *  Every call returns false when the panel's queue is full; the
+ *  command is then dropped and counted in render_dropped().
+ * ---------------------------------------------------------------------
+ */
+
+bool render_text(panel_id_t panel, size_t x, size_t y, const char *text, vga_color_t fg, vga_color_t bg);
+bool render_int(panel_id_t panel, size_t x, size_t y, int value, size_t digits, vga_color_t fg, vga_color_t bg);
+bool render_hline(panel_id_t panel, size_t x, size_t y, size_t length, vga_color_t color);
+bool render_vline(panel_id_t panel, size_t x, size_t y, size_t length, vga_color_t color);
+bool render_fill_rect(panel_id_t panel, size_t x0, size_t y0, size_t x1, size_t y1, vga_color_t color);
+
+// Numeric field that repaints only the digits that changed. The field
+// is set up with gfx_field_init() before its first use and from then
+// on only touched by the render task.
+bool render_field(panel_id_t panel, gfx_field_t *field, int value);
+
+// Transient draws: erased again by the next render_flush() of the panel
+bool render_text_transient(panel_id_t panel, size_t x, size_t y, const char *text, vga_color_t fg, vga_color_t bg);
+bool render_circle(panel_id_t panel, size_t x, size_t y, size_t radius, vga_color_t color);
+
+// Erase everything drawn transiently in the panel (compositor_flush)
+bool render_flush(panel_id_t panel);
+
+// True when the next commands calls for the panel all fit in its
+// queue. Otherwise they are counted as dropped and nothing is queued,
+// so a shape made of several commands is drawn whole or not at all.
+bool render_reserve(panel_id_t panel, size_t commands);
+
+// Number of commands dropped because a queue was full
+unsigned int render_dropped(panel_id_t panel);
+
+// Print the dropped commands of every panel (console)
+void render_report(void);
+
+// Execute every queued command and present the frame
+void render_drain(void);
+
+// Drawn by the render task once, before its first job: the screen
+// background (before tsw_on())
+void render_set_background(void (*draw)(void));
+
+// Task entry point
+void render_task_code(void);
+
+#endif /* RENDER_H_ */
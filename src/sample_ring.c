@@ -0,0 +1,167 @@
+#include <string.h>
+#include "barrier.h"
+#include "hot.h"
+#include "sample_ring.h"
+
+#if (SAMPLE_RING_SIZE & SAMPLE_RING_MASK) != 0
+#error "SAMPLE_RING_SIZE must be a power of two"
+#endif
+
+// Shared acquisition ring (producer: task_acc_code)
+sample_ring_t acc_ring HOT_DATA;
+
+void sample_ring_init(sample_ring_t *ring)
+{
+    ring->head = 0;
+}
+
+/* ================================================================
+ *                      PRODUCER
+ * ================================================================ */
+HOT_CODE void sample_ring_push(sample_ring_t *ring, const acc_sample_t *sample)
+{
+    alt_u32 head = ring->head;
+
+    ring->samples[head & SAMPLE_RING_MASK] = *sample;
+    compiler_barrier();     // Sample body before the new head
+    ring->head = head + 1;
+}
+
+/* ================================================================
+ *                      CONSUMERS
+ * ================================================================ */
+void sample_cursor_init(const sample_ring_t *ring, sample_cursor_t *cursor)
+{
+    cursor->next = ring->head;
+    cursor->lost = 0;
+}
+
+size_t sample_ring_available(const sample_ring_t *ring, const sample_cursor_t *cursor)
+{
+    alt_u32 pending = ring->head - cursor->next;
+
+    return pending > SAMPLE_RING_SIZE ? SAMPLE_RING_SIZE : pending;
+}
+
+// Skip what has already been overwritten; returns how many samples
+// (at most max) the caller may copy from cursor->next on
+static inline size_t read_begin(const sample_ring_t *ring, sample_cursor_t *cursor, size_t max)
+{
+    alt_u32 head = ring->head;
+    compiler_barrier();
+
+    if (head - cursor->next > SAMPLE_RING_SIZE)
+    {
+        cursor->lost += head - cursor->next - SAMPLE_RING_SIZE;
+        cursor->next = head - SAMPLE_RING_SIZE;
+    }
+
+    size_t count = head - cursor->next;
+    return count > max ? max : count;
+}
+
+// After copying count samples: the producer may have lapped the oldest
+// of them meanwhile. Returns how many leading copies are stale.
+static inline size_t read_end(const sample_ring_t *ring, sample_cursor_t *cursor, size_t count)
+{
+    compiler_barrier();
+
+    alt_u32 oldest_valid = ring->head - SAMPLE_RING_SIZE;
+    size_t stale = 0;
+
+    if ((alt_32)(oldest_valid - cursor->next) > 0)
+    {
+        stale = oldest_valid - cursor->next;
+        if (stale > count)
+            stale = count;
+
+        cursor->lost += stale;
+    }
+
+    cursor->next += count;
+    return stale;
+}
+
+HOT_CODE size_t sample_ring_read(const sample_ring_t *ring, sample_cursor_t *cursor, acc_sample_t *out, size_t max)
+{
+    size_t count = read_begin(ring, cursor, max);
+
+    for (size_t i = 0; i < count; i++)
+        out[i] = ring->samples[(cursor->next + i) & SAMPLE_RING_MASK];
+
+    size_t stale = read_end(ring, cursor, count);
+    if (stale > 0)
+        memmove(out, out + stale, (count - stale) * sizeof(*out));
+
+    return count - stale;
+}
+
+HOT_CODE size_t sample_ring_read_axes(const sample_ring_t *ring, sample_cursor_t *cursor,
+                                      alt_16 *x, alt_16 *y, alt_16 *z, size_t max)
+{
+    size_t count = read_begin(ring, cursor, max);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const position_t *p = &ring->samples[(cursor->next + i) & SAMPLE_RING_MASK].pos;
+
+        x[i] = p->x;
+        y[i] = p->y;
+        z[i] = p->z;
+    }
+
+    size_t stale = read_end(ring, cursor, count);
+    if (stale > 0)
+    {
+        memmove(x, x + stale, (count - stale) * sizeof(*x));
+        memmove(y, y + stale, (count - stale) * sizeof(*y));
+        memmove(z, z + stale, (count - stale) * sizeof(*z));
+    }
+
+    return count - stale;
+}
+
+size_t sample_ring_peek(const sample_ring_t *ring, sample_cursor_t *cursor, const acc_sample_t **span, size_t max)
+{
+    alt_u32 head = ring->head;
+    compiler_barrier();
+
+    if (head - cursor->next > SAMPLE_RING_SIZE)
+    {
+        cursor->lost += head - cursor->next - SAMPLE_RING_SIZE;
+        cursor->next = head - SAMPLE_RING_SIZE;
+    }
+
+    size_t index = cursor->next & SAMPLE_RING_MASK;
+    size_t count = head - cursor->next;
+
+    if (count > SAMPLE_RING_SIZE - index)
+        count = SAMPLE_RING_SIZE - index;
+    if (count > max)
+        count = max;
+
+    *span = &ring->samples[index];
+    return count;
+}
+
+void sample_ring_consume(sample_cursor_t *cursor, size_t count)
+{
+    cursor->next += count;
+}
+
+bool sample_ring_latest(const sample_ring_t *ring, acc_sample_t *out)
+{
+    alt_u32 head;
+
+    do {
+        head = ring->head;
+        if (head == 0)
+            return false;
+
+        compiler_barrier();
+        *out = ring->samples[(head - 1) & SAMPLE_RING_MASK];
+        compiler_barrier();
+    } while (ring->head - head >= SAMPLE_RING_SIZE);
+
+    return true;
+}
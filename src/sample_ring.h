@@ -0,0 +1,69 @@
+#ifndef SAMPLE_RING_H_
+#define SAMPLE_RING_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "app_config.h"
+#include "position.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  ACCELEROMETER SAMPLE RING
+ * ---------------------------------------------------------------------
+ *  Power-of-two ring written by the acquisition task only. Consumers
+ *  never modify the ring: each keeps its own cursor, so any number of
+ *  them can read at their own pace. A consumer that falls more than
+ *  SAMPLE_RING_SIZE samples behind skips forward and counts what it
+ *  lost instead of blocking the producer.
+ *
+ *  Samples are stored as whole records (array of structs): the host
+ *  DMA and stream send them as they are. Consumers that work per axis
+ *  read them split into one array per axis instead.
+ * ---------------------------------------------------------------------
+ */
+
+#define SAMPLE_RING_MASK (SAMPLE_RING_SIZE - 1)
+
+typedef struct sample_ring {
+    volatile alt_u32 head;                  // Total samples written
+    acc_sample_t samples[SAMPLE_RING_SIZE];
+} sample_ring_t;
+
+// Per-consumer read position
+typedef struct sample_cursor {
+    alt_u32 next;       // Index of the next sample to read
+    alt_u32 lost;       // Samples overwritten before they were read
+} sample_cursor_t;
+
+extern sample_ring_t acc_ring;
+
+void sample_ring_init(sample_ring_t *ring);
+
+// Producer: append one sample
+void sample_ring_push(sample_ring_t *ring, const acc_sample_t *sample);
+
+// Consumer: start reading at the current head (only new samples)
+void sample_cursor_init(const sample_ring_t *ring, sample_cursor_t *cursor);
+
+// Number of samples waiting for this cursor
+size_t sample_ring_available(const sample_ring_t *ring, const sample_cursor_t *cursor);
+
+// Copy up to max unread samples to out, returns how many were copied
+size_t sample_ring_read(const sample_ring_t *ring, sample_cursor_t *cursor, acc_sample_t *out, size_t max);
+
+// Same, but split into one array per axis (structure of arrays) for
+// consumers that process the axes separately; timestamps are dropped
+size_t sample_ring_read_axes(const sample_ring_t *ring, sample_cursor_t *cursor,
+                             alt_16 *x, alt_16 *y, alt_16 *z, size_t max);
+
+// Zero-copy access: point *span at the longest contiguous run of
+// unread samples (at most max, stopping at the end of the ring) and
+// return its length. The cursor only moves with sample_ring_consume();
+// the run stays valid until the producer laps it.
+size_t sample_ring_peek(const sample_ring_t *ring, sample_cursor_t *cursor, const acc_sample_t **span, size_t max);
+void sample_ring_consume(sample_cursor_t *cursor, size_t count);
+
+// Copy the most recent sample, false if nothing was written yet
+bool sample_ring_latest(const sample_ring_t *ring, acc_sample_t *out);
+
+#endif /* SAMPLE_RING_H_ */
@@ -0,0 +1,56 @@
+#ifndef SEQLOCK_H_
+#define SEQLOCK_H_
+
+#include <alt_types.h>
+#include "barrier.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  SINGLE-WRITER PUBLICATION (TWO-SLOT SEQLOCK)
+ * ---------------------------------------------------------------------
+ *  Publishes a small value from one writer task to any number of
+ *  readers without a kernel call. The writer fills the slot that is not
+ *  current and then bumps the sequence counter, so it never waits. A
+ *  reader copies the current slot and retries only if the writer
+ *  published twice during that copy (the only way its slot can be
+ *  overwritten). Because the writer never leaves a half-written current
+ *  slot, a reader that preempts the writer does not spin either, for
+ *  any priority order.
+ *
+ *      SEQLOCK(position_t) shared;
+ *      seqlock_write(&shared, sample);     // writer
+ *      seqlock_read(&shared, &copy);       // readers
+ * ---------------------------------------------------------------------
+ */
+
+#define SEQLOCK(type)                   \
+    struct {                            \
+        volatile alt_u32 sequence;      \
+        type slot[2];                   \
+    }
+
+// Publish a new value (single writer only)
+#define seqlock_write(lock, value)                          \
+    do {                                                    \
+        alt_u32 seq_next_ = (lock)->sequence + 1;           \
+        (lock)->slot[seq_next_ & 1] = (value);              \
+        compiler_barrier();                                 \
+        (lock)->sequence = seq_next_;                       \
+    } while (0)
+
+// Copy the latest value to *out
+#define seqlock_read(lock, out)                             \
+    do {                                                    \
+        alt_u32 seq_start_;                                 \
+        do {                                                \
+            seq_start_ = (lock)->sequence;                  \
+            compiler_barrier();                             \
+            *(out) = (lock)->slot[seq_start_ & 1];          \
+            compiler_barrier();                             \
+        } while ((lock)->sequence - seq_start_ >= 2);       \
+    } while (0)
+
+// Number of values published so far (lets readers detect new data)
+#define seqlock_sequence(lock) ((alt_u32)(lock)->sequence)
+
+#endif /* SEQLOCK_H_ */
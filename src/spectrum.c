@@ -0,0 +1,197 @@
+#include "altera_avalon_sierra_ker.h"
+#include "position.h"
+#include "render.h"
+#include "sample_ring.h"
+#include "spectrum.h"
+#include "task_stats.h"
+
+#if SPECTRUM
+
+#define BINS_PER_BAR (SPECTRUM_POINTS / 2 / SPECTRUM_BARS)
+
+spectrum_lock_t spectrum_data;
+
+/* ================================================================
+ *                          TRANSFORM
+ * ================================================================ */
+// Log scale of the magnitude above the noise floor: 8 levels per
+// octave (the leading bit and the three below it), 0..127 for 16-bit
+// magnitudes, mapped onto the bar height. Without the floor a
+// magnitude of 2, rounding noise, would already be 6 rows high.
+static alt_u8 bar_height(alt_u32 magnitude)
+{
+    unsigned msb = 0;
+    unsigned fraction;
+
+    if (magnitude <= SPECTRUM_NOISE_FLOOR)
+        return 0;
+
+    magnitude -= SPECTRUM_NOISE_FLOOR;
+
+    while (magnitude >> (msb + 1))
+        msb++;
+
+    fraction = msb >= 3 ? (magnitude >> (msb - 3)) & 7 : (magnitude << (3 - msb)) & 7;
+    return (alt_u8)((8 * msb + fraction) * SPECTRUM_HEIGHT / 128);
+}
+
+static void transform(const alt_16 *block, spectrum_t *out)
+{
+    static complex_q15_t buffer[SPECTRUM_POINTS];
+    alt_32 sum = 0;
+
+    for (size_t i = 0; i < SPECTRUM_POINTS; i++)
+        sum += block[i];
+
+    // Without its mean gravity would leak into the low bins
+    const alt_32 mean = sum >> SPECTRUM_FFT_LOG2;
+
+    for (size_t i = 0; i < SPECTRUM_POINTS; i++)
+    {
+        alt_32 v = (block[i] - mean) * (1 << SPECTRUM_INPUT_SHIFT);
+
+        if (v > FFT_INPUT_MAX)
+            v = FFT_INPUT_MAX;
+        if (v < -FFT_INPUT_MAX)
+            v = -FFT_INPUT_MAX;
+
+        buffer[i].re = (q15_t)v;
+        buffer[i].im = 0;
+    }
+
+    fft_window_hann(buffer, SPECTRUM_FFT_LOG2);
+    fft_q15(buffer, SPECTRUM_FFT_LOG2);
+
+    for (size_t b = 0; b < SPECTRUM_BARS; b++)
+    {
+        alt_u32 peak = 0;
+
+        for (size_t k = b * BINS_PER_BAR; k < (b + 1) * BINS_PER_BAR; k++)
+        {
+            alt_u32 m = fft_magnitude(buffer[k]);
+
+            if (m > peak)
+                peak = m;
+        }
+
+        out->bars[b] = bar_height(peak);
+    }
+
+    out->blocks++;
+}
+
+/* ================================================================
+ *                           TASK
+ *  Samples are collected until a block is full; the job that
+ *  completes it transforms it and publishes the bars. A job never
+ *  reads past one block, so a late job leaves the rest in the ring
+ *  for the next one instead of running several transforms.
+ * ================================================================ */
+void spectrum_task_code(void)
+{
+    static task_stats_t stats;
+    static alt_16 axes[AXIS_COUNT][FILTER_BLOCK];
+    static alt_16 block[SPECTRUM_POINTS];
+    static spectrum_t out;
+    sample_cursor_t cursor;
+    size_t filled = 0;
+
+    init_period_time(SPECTRUM_PERIOD_TICKS);
+    task_stats_init(&stats, "SPECTRUM", SPECTRUM_PERIOD_TICKS);
+
+    sample_cursor_init(&acc_ring, &cursor);
+
+    while (1)
+    {
+        task_stats_wait(&stats);
+
+        while (filled < SPECTRUM_POINTS)
+        {
+            size_t want = SPECTRUM_POINTS - filled;
+            size_t count = sample_ring_read_axes(&acc_ring, &cursor,
+                                                 axes[AXIS_X], axes[AXIS_Y], axes[AXIS_Z],
+                                                 want < FILTER_BLOCK ? want : FILTER_BLOCK);
+
+            if (count == 0)
+                break;
+
+            for (size_t i = 0; i < count; i++)
+                block[filled++] = axes[SPECTRUM_AXIS][i];
+        }
+
+        if (filled < SPECTRUM_POINTS)
+            continue;
+
+        transform(block, &out);
+        seqlock_write(&spectrum_data, out);
+        filled = 0;
+    }
+}
+
+/* ================================================================
+ *                          VIEW
+ *  Each changed bar costs one fill: the rows it gained in the bar
+ *  colour or the rows it lost in the background. A bar whose fill
+ *  did not fit in the render queue keeps its old height in shown[]
+ *  and ends the update; the next one starts with it. Bar b covers
+ *  columns b * width / SPECTRUM_BARS up to the start of bar b + 1,
+ *  less one column of gap when that leaves it at least one.
+ * ================================================================ */
+void spectrum_view_init(spectrum_view_t *view, panel_id_t panel,
+                        size_t x0, size_t width, size_t bottom,
+                        vga_color_t bar, vga_color_t background)
+{
+    view->panel = panel;
+    view->x0 = x0;
+    view->bottom = bottom;
+    view->width = width;
+    view->bar = bar;
+    view->background = background;
+    view->next = 0;
+
+    for (size_t b = 0; b < SPECTRUM_BARS; b++)
+        view->shown[b] = 0;
+}
+
+void spectrum_view_update(spectrum_view_t *view)
+{
+    spectrum_t s;
+    size_t drawn = 0;
+    size_t b = view->next;
+
+    seqlock_read(&spectrum_data, &s);
+
+    for (size_t scanned = 0; scanned < SPECTRUM_BARS && drawn < SPECTRUM_BARS_PER_JOB; scanned++)
+    {
+        alt_u8 want = s.bars[b];
+        alt_u8 have = view->shown[b];
+
+        if (want != have)
+        {
+            size_t x = view->x0 + b * view->width / SPECTRUM_BARS;
+            size_t end = view->x0 + (b + 1) * view->width / SPECTRUM_BARS;
+            // One column between bars when they are wide enough
+            size_t x1 = end - x > 1 ? end - 2 : x;
+            bool queued;
+
+            if (want > have)
+                queued = render_fill_rect(view->panel, x, view->bottom - want + 1,
+                                          x1, view->bottom - have, view->bar);
+            else
+                queued = render_fill_rect(view->panel, x, view->bottom - have + 1,
+                                          x1, view->bottom - want, view->background);
+
+            if (!queued)
+                break;
+
+            view->shown[b] = want;
+            drawn++;
+        }
+
+        b = (b + 1) % SPECTRUM_BARS;
+    }
+
+    view->next = b;
+}
+
+#endif /* SPECTRUM */
@@ -0,0 +1,78 @@
+#ifndef SPECTRUM_H_
+#define SPECTRUM_H_
+
+#include <stddef.h>
+#include <alt_types.h>
+#include "app_config.h"
+#include "compositor.h"
+#include "fft.h"
+#include "seqlock.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  SPECTRUM
+ * ---------------------------------------------------------------------
+ *  With SPECTRUM enabled a task of its own collects SPECTRUM_POINTS
+ *  samples of SPECTRUM_AXIS from the acquisition ring, removes their
+ *  mean, applies a Hann window and runs fft_q15(). Every job handles
+ *  at most one block, so its cost is fixed; its period is the time
+ *  one block takes to arrive, the longest in the table, which gives
+ *  it the lowest priority. The bins 0..n/2-1 are grouped into
+ *  SPECTRUM_BARS bars (the largest bin of each) and published
+ *  through spectrum_data as bar heights on a log scale of the
+ *  magnitude above SPECTRUM_NOISE_FLOOR: 8 levels per octave (6 dB),
+ *  0..127 for 16-bit magnitudes, scaled to SPECTRUM_HEIGHT rows.
+ *
+ *  The panel keeps a single owner: the plot task draws the published
+ *  bars with a spectrum view instead of the strip chart. A view
+ *  redraws only the bars whose height changed, at most
+ *  SPECTRUM_BARS_PER_JOB per update, each with one fill of the rows
+ *  that changed. The bars share the view's width between them, so
+ *  they span it edge to edge.
+ * ---------------------------------------------------------------------
+ */
+
+#if SPECTRUM
+
+#define SPECTRUM_POINTS   (1u << SPECTRUM_FFT_LOG2)
+#define SPECTRUM_HEIGHT   100     // Rows of the tallest bar
+
+typedef struct spectrum {
+    alt_u8 bars[SPECTRUM_BARS];         // Height in rows, 0..SPECTRUM_HEIGHT
+    alt_u32 blocks;                     // Transforms so far
+} spectrum_t;
+
+typedef SEQLOCK(spectrum_t) spectrum_lock_t;
+
+// Latest bars (written by the spectrum task only)
+extern spectrum_lock_t spectrum_data;
+
+// Task entry point (task table)
+void spectrum_task_code(void);
+
+/* ================================================================
+ *                          VIEW
+ * ================================================================ */
+typedef struct spectrum_view {
+    panel_id_t panel;
+    size_t x0;                          // Left edge of the first bar
+    size_t bottom;                      // Row of the bar bases
+    size_t width;                       // Columns across all bars
+    vga_color_t bar;
+    vga_color_t background;
+    size_t next;                        // Bar the next update starts at
+    alt_u8 shown[SPECTRUM_BARS];        // Heights on screen
+} spectrum_view_t;
+
+// Bars over width columns, growing up from bottom; the area above
+// them must already be cleared to background
+void spectrum_view_init(spectrum_view_t *view, panel_id_t panel,
+                        size_t x0, size_t width, size_t bottom,
+                        vga_color_t bar, vga_color_t background);
+
+// Redraw up to SPECTRUM_BARS_PER_JOB changed bars of spectrum_data
+void spectrum_view_update(spectrum_view_t *view);
+
+#endif /* SPECTRUM */
+
+#endif /* SPECTRUM_H_ */
@@ -0,0 +1,94 @@
+#include "render.h"
+#include "strip_chart.h"
+
+#if STRIP_CHART_PUSH_CMDS > RENDER_QUEUE_SIZE
+#error "RENDER_QUEUE_SIZE must hold one strip chart column"
+#endif
+
+void strip_chart_init(strip_chart_t *chart, panel_id_t panel,
+                      size_t x0, size_t width, size_t top, size_t bottom, size_t baseline,
+                      vga_color_t trace, vga_color_t axis, vga_color_t background)
+{
+    if (width > STRIP_CHART_MAX_WIDTH)
+        width = STRIP_CHART_MAX_WIDTH;
+
+    chart->panel = panel;
+    chart->x0 = x0;
+    chart->width = width;
+    chart->top = top;
+    chart->bottom = bottom;
+    chart->baseline = baseline;
+    chart->trace = trace;
+    chart->axis = axis;
+    chart->background = background;
+    chart->cursor = 0;
+
+    for (size_t i = 0; i < width; i++)
+        chart->rows[i] = baseline;
+}
+
+void strip_chart_draw_frame(const strip_chart_t *chart)
+{
+    render_fill_rect(chart->panel,
+                     chart->x0, chart->top,
+                     chart->x0 + chart->width - 1, chart->bottom,
+                     chart->background);
+    render_hline(chart->panel, chart->x0, chart->baseline, chart->width, chart->axis);
+}
+
+/* ================================================================
+ *                      COLUMN UPDATE
+ *  Overwrites the oldest column with the new value and connects it
+ *  to the previous value with a vertical segment. One column ahead
+ *  of the cursor is cleared as well so the sweep position stays
+ *  visible as a gap in the trace. The five commands are reserved
+ *  together, so a full queue skips the column instead of leaving it
+ *  half drawn.
+ * ================================================================ */
+static void erase_column(const strip_chart_t *chart, size_t x)
+{
+    render_vline(chart->panel, x, chart->top, chart->bottom - chart->top + 1, chart->background);
+    render_hline(chart->panel, x, chart->baseline, 1, chart->axis);
+}
+
+bool strip_chart_push(strip_chart_t *chart, int value)
+{
+    int y = (int)chart->baseline - value;
+    size_t x = chart->x0 + chart->cursor;
+    alt_u16 prev = chart->rows[chart->cursor == 0 ? chart->width - 1 : chart->cursor - 1];
+    size_t y0;
+    size_t y1;
+
+    if (!render_reserve(chart->panel, STRIP_CHART_PUSH_CMDS))
+        return false;
+
+    if (y < chart->top)
+        y = chart->top;
+    if (y > chart->bottom)
+        y = chart->bottom;
+
+    // Segment from the previous value to the new one (a single pixel
+    // when the value did not change)
+    if ((alt_u16)y < prev)
+    {
+        y0 = y;
+        y1 = prev;
+    }
+    else
+    {
+        y0 = prev;
+        y1 = y;
+    }
+
+    erase_column(chart, x);
+    render_vline(chart->panel, x, y0, y1 - y0 + 1, chart->trace);
+
+    chart->rows[chart->cursor] = y;
+
+    if (++chart->cursor == chart->width)
+        chart->cursor = 0;
+
+    // Keep a blank column in front of the newest value
+    erase_column(chart, chart->x0 + chart->cursor);
+    return true;
+}
@@ -0,0 +1,55 @@
+#ifndef STRIP_CHART_H_
+#define STRIP_CHART_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <alt_types.h>
+#include "app_config.h"
+#include "compositor.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  STRIP CHART
+ * ---------------------------------------------------------------------
+ *  Sweep-style graph that keeps one value per screen column in a
+ *  circular buffer. Each strip_chart_push() only repaints the column
+ *  under the sweep cursor (erase, baseline pixel, line segment from the
+ *  previous value), so the cost per update is constant regardless of
+ *  the chart size.
+ *
+ *  All drawing goes through the render queue of the chart's panel, so
+ *  a chart must be driven by the task that owns that panel.
+ * ---------------------------------------------------------------------
+ */
+
+// Draw commands queued by one strip_chart_push()
+#define STRIP_CHART_PUSH_CMDS 5
+
+typedef struct strip_chart {
+    panel_id_t panel;
+    alt_u16 x0;                             // Leftmost column
+    alt_u16 width;                          // Number of columns
+    alt_u16 top;                            // Drawing area [top..bottom]
+    alt_u16 bottom;
+    alt_u16 baseline;                       // Row of the zero value
+    vga_color_t trace;
+    vga_color_t axis;
+    vga_color_t background;
+    alt_u16 cursor;                         // Next column to repaint
+    alt_u16 rows[STRIP_CHART_MAX_WIDTH];    // Row plotted in each column
+} strip_chart_t;
+
+void strip_chart_init(strip_chart_t *chart, panel_id_t panel,
+                      size_t x0, size_t width, size_t top, size_t bottom, size_t baseline,
+                      vga_color_t trace, vga_color_t axis, vga_color_t background);
+
+// Queue the static parts (background and baseline) of the chart
+void strip_chart_draw_frame(const strip_chart_t *chart);
+
+// Append one value, in pixels above the baseline (negative = below).
+// Returns false, leaving the chart as it was, when the panel's render
+// queue has no room for the whole column; the commands are counted as
+// dropped (render_dropped()).
+bool strip_chart_push(strip_chart_t *chart, int value);
+
+#endif /* STRIP_CHART_H_ */
@@ -0,0 +1,167 @@
+#include <string.h>
+#include "altera_avalon_sierra_ker.h"
+#include <sys/alt_timestamp.h>
+#include "log.h"
+#include "task_stats.h"
+#include "trace.h"
+
+static task_stats_t *registry[TASK_STATS_MAX];
+static size_t registered;
+
+// Guards registration and the record copies of the dump. Not listed
+// by mutex_report(): it can be locked before mutex_init() could run.
+static mutex_t stats_mutex = { "task_stats", 0, 0, CONSOLE_CS_US };
+
+void task_stats_init(task_stats_t *stats, const char *name, alt_u32 period_ticks)
+{
+    memset(stats, 0, sizeof(*stats));
+
+    stats->name = name;
+    stats->period = (alt_timestamp_freq() / 1000) * RTK_TICK_MS * period_ticks;
+    stats->exec_min = 0xFFFFFFFF;
+    stats->latency_min = 0xFFFFFFFF;
+
+    // Only called from task start-up code, before the first wait
+    mutex_lock(&stats_mutex);
+    if (registered < TASK_STATS_MAX)
+    {
+        stats->id = registered;
+        registry[registered++] = stats;
+    }
+    else
+    {
+        stats->id = TASK_STATS_MAX;     // Traced under an unnamed id
+    }
+    mutex_unlock(&stats_mutex);
+}
+
+size_t task_stats_count(void)
+{
+    return registered;
+}
+
+const char *task_stats_name(size_t id)
+{
+    return id < registered ? registry[id]->name : "?";
+}
+
+/* ================================================================
+ *                      JOB BOUNDARIES
+ * ================================================================ */
+static void job_end(task_stats_t *s, alt_u32 now)
+{
+    alt_u32 exec = now - s->start;
+    alt_u32 response = now - s->release;
+
+    if (exec < s->exec_min) s->exec_min = exec;
+    if (exec > s->exec_max) s->exec_max = exec;
+    if (response > s->response_max) s->response_max = response;
+    s->exec_sum += exec;
+}
+
+static void job_start(task_stats_t *s, alt_u32 now)
+{
+    alt_u32 latency;
+
+    if (s->jobs == 0 || s->period == 0)
+        s->release = now;
+    else
+        s->release += s->period;
+
+    // Started before the predicted release: the estimate has drifted
+    if ((alt_32)(now - s->release) < 0)
+        s->release = now;
+
+    latency = now - s->release;
+
+    if (latency < s->latency_min) s->latency_min = latency;
+    if (latency > s->latency_max) s->latency_max = latency;
+
+    s->start = now;
+    s->jobs++;
+}
+
+bool task_stats_wait(task_stats_t *stats)
+{
+    task_periodic_start_union deadline;
+    bool missed;
+
+    if (stats->running)
+    {
+        job_end(stats, alt_timestamp());
+        trace_record(TRACE_TASK_SLEEP, stats->id, 0);
+    }
+
+    deadline = wait_for_next_period();
+    missed = (deadline.periodic_start_integer & 0x1) != 0;
+
+    trace_record(TRACE_TASK_WAKE, stats->id, 0);
+    job_start(stats, alt_timestamp());
+    stats->running = true;
+
+    if (missed)
+    {
+        stats->misses++;
+        trace_record(TRACE_DEADLINE_MISS, stats->id, (alt_u16)stats->misses);
+        LOG("Deadline miss: %s task (%u)\n", stats->name, stats->misses);
+    }
+
+    return missed;
+}
+
+void task_stats_wait_sem(task_stats_t *stats, int sem)
+{
+    if (stats->running)
+    {
+        job_end(stats, alt_timestamp());
+        trace_record(TRACE_TASK_SLEEP, stats->id, 0);
+    }
+
+    trace_sem_take(stats->id, sem);
+
+    trace_record(TRACE_TASK_WAKE, stats->id, 0);
+    job_start(stats, alt_timestamp());
+    stats->running = true;
+}
+
+/* ================================================================
+ *                           DUMP
+ *  Copies each record under stats_mutex (task switching off) so a
+ *  task cannot update it half-way through, then prints outside it.
+ * ================================================================ */
+static alt_u32 to_us(alt_u64 ticks)
+{
+    return (alt_u32)(ticks * 1000000 / alt_timestamp_freq());
+}
+
+void task_stats_dump(void)
+{
+    task_stats_t s;
+
+    console_printf("%-12s %8s %6s %8s %8s %8s %8s %8s\n",
+                   "task", "jobs", "miss", "exec_min", "exec_avg", "exec_max", "resp_max", "jitter");
+
+    for (size_t i = 0; i < registered; i++)
+    {
+        mutex_lock(&stats_mutex);
+        s = *registry[i];
+        mutex_unlock(&stats_mutex);
+
+        if (s.jobs < 2)
+        {
+            console_printf("%-12s %8lu (no complete job yet)\n", s.name, (unsigned long)s.jobs);
+            continue;
+        }
+
+        // The newest job may still be running: average over ended ones
+        console_printf("%-12s %8lu %6lu %8lu %8lu %8lu %8lu %8lu\n",
+                       s.name,
+                       (unsigned long)s.jobs,
+                       (unsigned long)s.misses,
+                       (unsigned long)to_us(s.exec_min),
+                       (unsigned long)to_us(s.exec_sum / (s.jobs - 1)),
+                       (unsigned long)to_us(s.exec_max),
+                       (unsigned long)to_us(s.response_max),
+                       (unsigned long)to_us(s.latency_max - s.latency_min));
+    }
+}
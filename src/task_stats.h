@@ -0,0 +1,68 @@
+#ifndef TASK_STATS_H_
+#define TASK_STATS_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <alt_types.h>
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  PER-TASK TIMING STATISTICS
+ * ---------------------------------------------------------------------
+ *  Each periodic task waits through task_stats_wait() instead of
+ *  calling wait_for_next_period() directly. That closes the previous
+ *  job, waits, and opens the next one, timestamping both edges with
+ *  the free-running alt_timestamp() counter. Nothing is printed from
+ *  the tasks themselves: deadline misses are counted, traced
+ *  (trace.h) and reported through the deferred log (log.h).
+ *
+ *  The kernel does not report release times, so they are estimated
+ *  from the first activation plus one period per job. The estimate is
+ *  moved forward whenever a job starts earlier than predicted, which
+ *  keeps clock drift between the RTK tick and the timestamp timer out
+ *  of the latency figures.
+ *
+ *  All times are in alt_timestamp() ticks. "exec" is the start-to-end
+ *  time of a job and includes preemption by higher-priority tasks.
+ * ---------------------------------------------------------------------
+ */
+
+typedef struct task_stats {
+    const char *name;
+    alt_u8 id;              // Registration index, also the trace id
+    alt_u32 period;         // Period in timestamp ticks
+    alt_u32 release;        // Estimated release of the current job
+    alt_u32 start;          // Start of the current job
+    bool running;           // A job has been started and not ended
+    alt_u32 jobs;
+    alt_u32 misses;         // Deadline misses reported by the kernel
+    alt_u32 exec_min;
+    alt_u32 exec_max;
+    alt_u64 exec_sum;
+    alt_u32 response_max;   // Release to end
+    alt_u32 latency_min;    // Release to start; jitter = max - min
+    alt_u32 latency_max;
+} task_stats_t;
+
+// Register a task's statistics (call once from the task, after
+// alt_timestamp_start()); period is in RTK ticks, 0 for a task that is
+// released by a semaphore (its release is taken as the start time)
+void task_stats_init(task_stats_t *stats, const char *name, alt_u32 period_ticks);
+
+// End the current job, wait for the next period and start the next
+// job. Returns true when the kernel reported a deadline miss.
+bool task_stats_wait(task_stats_t *stats);
+
+// Same for a semaphore-released task: end the job, sem_take(sem) and
+// start the next job
+void task_stats_wait_sem(task_stats_t *stats, int sem);
+
+// Registered tasks, by trace id
+size_t task_stats_count(void);
+const char *task_stats_name(size_t id);
+
+// Print a table of every registered task (times in microseconds)
+void task_stats_dump(void);
+
+#endif /* TASK_STATS_H_ */
@@ -0,0 +1,175 @@
+#include <stdio.h>
+#include "altera_avalon_sierra_ker.h"
+#include "hot.h"
+#include "log.h"
+#include "tasks.h"
+
+#if TASK_UTILIZATION > RM_BOUND(TASK_TABLE_SIZE)
+#warning "Task utilization above the Liu-Layland bound: relying on the start-up response-time analysis"
+#endif
+
+// Task stacks (Nios II stacks grow down, from the end of the array)
+static char idle_stack[IDLE_STACK_SIZE] HOT_DATA;
+
+#define TASK_STACK_DEF_(id, entry, period, deadline, budget, cs, stack) \
+    static char entry##_stack[stack] HOT_DATA;
+TASK_TABLE(TASK_STACK_DEF_)
+
+#define TASK_DESC_(id, entry, period, deadline, budget, cs, stack) \
+    { id, #id, entry, period, deadline, budget, cs, entry##_stack, stack, 0 },
+task_desc_t task_table[TASK_COUNT] = {
+    TASK_TABLE(TASK_DESC_)
+};
+
+/* ================================================================
+ *                  RATE-MONOTONIC PRIORITIES
+ *  Priority = 1 + number of distinct periods longer than the task's
+ *  own, so the fastest task gets the highest value (runs first).
+ * ================================================================ */
+void tasks_assign_priorities(void)
+{
+    for (size_t i = 0; i < TASK_COUNT; i++)
+    {
+        int priority = 1;
+
+        for (size_t j = 0; j < TASK_COUNT; j++)
+        {
+            bool counted = false;
+
+            // Count each longer period once
+            for (size_t k = 0; k < j; k++)
+                if (task_table[k].period == task_table[j].period)
+                    counted = true;
+
+            if (!counted && task_table[j].period > task_table[i].period)
+                priority++;
+        }
+
+        task_table[i].priority = priority;
+    }
+}
+
+/* ================================================================
+ *                  RESPONSE-TIME ANALYSIS
+ *  R = C + B + sum over interfering tasks j of ceil(R / T_j) * C_j,
+ *  iterated to a fixed point. Tasks of equal priority are counted
+ *  as interfering, which is pessimistic but safe.
+ *
+ *  B is the blocking time. A mutex holder runs with task switching
+ *  off (mutex.h), so any lower-priority task, the idle task included,
+ *  can delay a job by its longest section, once per job.
+ *  Console sections are one bounded non-blocking write (log.h), so
+ *  their length does not depend on a host reading the UART.
+ * ================================================================ */
+static alt_u32 ticks_to_us(alt_u32 ticks)
+{
+    return ticks * RTK_TICK_MS * 1000;
+}
+
+static alt_u32 blocking_us(const task_desc_t *t)
+{
+    alt_u32 blocking = IDLE_CS_US;
+
+    for (size_t j = 0; j < TASK_COUNT; j++)
+    {
+        const task_desc_t *o = &task_table[j];
+
+        if (o->priority < t->priority && o->cs_us > blocking)
+            blocking = o->cs_us;
+    }
+
+    return blocking;
+}
+
+bool tasks_schedulable(void)
+{
+    bool ok = true;
+
+    for (size_t i = 0; i < TASK_COUNT; i++)
+    {
+        const task_desc_t *t = &task_table[i];
+        alt_u32 deadline = ticks_to_us(t->deadline);
+        alt_u32 own = t->budget_us + blocking_us(t);
+        alt_u32 response = own;
+        alt_u32 previous = 0;
+
+        while (response != previous && response <= deadline)
+        {
+            previous = response;
+            response = own;
+
+            for (size_t j = 0; j < TASK_COUNT; j++)
+            {
+                const task_desc_t *o = &task_table[j];
+                alt_u32 period = ticks_to_us(o->period);
+
+                if (j == i || o->priority < t->priority)
+                    continue;
+
+                response += ((previous + period - 1) / period) * o->budget_us;
+            }
+        }
+
+        if (response > deadline)
+        {
+            printf("%s may miss its deadline (response %lu us > %lu us)\n",
+                   t->name, (unsigned long)response, (unsigned long)deadline);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+/* ================================================================
+ *                  CREATION AND STACK USAGE
+ * ================================================================ */
+#define STACK_PAINT 0xA5
+
+static void paint_stack(char *stack, size_t size)
+{
+    for (size_t i = 0; i < size; i++)
+        stack[i] = STACK_PAINT;
+}
+
+void tasks_create(void (*idle)(void))
+{
+    paint_stack(idle_stack, sizeof(idle_stack));
+    task_create(TASK_IDLE, 0, READY_TASK_STATE, idle, idle_stack, sizeof(idle_stack));
+
+    for (size_t i = 0; i < TASK_COUNT; i++)
+    {
+        const task_desc_t *t = &task_table[i];
+
+        paint_stack(t->stack, t->stack_size);
+        task_create(t->id, t->priority, READY_TASK_STATE, t->entry, t->stack, t->stack_size);
+    }
+}
+
+size_t tasks_stack_unused(const char *stack, size_t size)
+{
+    size_t unused = 0;
+
+    while (unused < size && (alt_u8)stack[unused] == STACK_PAINT)
+        unused++;
+
+    return unused;
+}
+
+static void report_stack(const char *name, const char *stack, size_t size)
+{
+    size_t unused = tasks_stack_unused(stack, size);
+
+    console_printf("%-16s %5lu / %5lu%s\n", name,
+                   (unsigned long)(size - unused), (unsigned long)size,
+                   unused == 0 ? "  OVERFLOW" : "");
+}
+
+void tasks_stack_report(void)
+{
+    console_printf("%-16s %13s\n", "stack", "used / size");
+    report_stack("TASK_IDLE", idle_stack, sizeof(idle_stack));
+
+    for (size_t i = 0; i < TASK_COUNT; i++)
+        report_stack(task_table[i].name, task_table[i].stack, task_table[i].stack_size);
+}
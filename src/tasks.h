@@ -0,0 +1,132 @@
+#ifndef TASKS_H_
+#define TASKS_H_
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <alt_types.h>
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  TASK TABLE
+ * ---------------------------------------------------------------------
+ *  Every periodic task is declared once in TASK_TABLE. main() creates
+ *  them from the table with rate-monotonic priorities: the shorter the
+ *  period, the higher the priority, equal periods share a priority.
+ *
+ *  Budgets (worst-case execution time in microseconds) feed a
+ *  build-time utilization check against the Liu-Layland bound and a
+ *  response-time analysis at start-up. Keep them above the exec_max
+ *  reported by task_stats_dump(). cs is the task's longest mutex
+ *  section in microseconds (mutex.h), 0 if it takes none; the analysis
+ *  counts it as blocking time of every higher-priority task.
+ *
+ *  Periods and deadlines are in RTK ticks (RTK_TICK_MS each). Stack
+ *  sizes are in bytes; every stack is painted before task_create() so
+ *  tasks_stack_report() can show how much of it was ever used.
+ * ---------------------------------------------------------------------
+ */
+
+//      id               entry                  period                   deadline                 budget   cs  stack
+#define TASK_TABLE(X) \
+    X(TASK_TIMER,      timer_task_code,       TIMER_PERIOD_TICKS,      TIMER_PERIOD_TICKS,         200,   0,  512) \
+    X(TASK_ACC,        task_acc_code,         ACC_PERIOD_TICKS,        ACC_PERIOD_TICKS,          2000,   0,  640) \
+    X(TASK_ACC_FILTER, task_acc_filter_code,  FILTER_ARRIVAL_TICKS,    FILTER_ARRIVAL_TICKS,     30000,   0,  800) \
+    X(TASK_PLOT,       task_plot_code,        PLOT_ARRIVAL_TICKS,      PLOT_ARRIVAL_TICKS,        1000,   0,  512) \
+    X(TASK_RENDER,     render_task_code,      RENDER_PERIOD_TICKS,     RENDER_PERIOD_TICKS,      20000,   0,  640) \
+    TASK_TABLE_STREAM(X) \
+    TASK_TABLE_SPECTRUM(X)
+
+// Optional rows
+#if HOST_STREAM
+#define TASK_TABLE_STREAM(X) \
+    X(TASK_STREAM,     host_stream_task_code, HOST_STREAM_PERIOD_TICKS, HOST_STREAM_PERIOD_TICKS, 5000, CONSOLE_CS_US, 640)
+#else
+#define TASK_TABLE_STREAM(X)
+#endif
+
+#if SPECTRUM
+#define TASK_TABLE_SPECTRUM(X) \
+    X(TASK_SPECTRUM,   spectrum_task_code,    SPECTRUM_PERIOD_TICKS,   SPECTRUM_PERIOD_TICKS,   100000,   0,  640)
+#else
+#define TASK_TABLE_SPECTRUM(X)
+#endif
+
+// With ACC_EVENTS the filter and plot tasks are released by the
+// acquisition task once enough samples arrived. They are analysed as
+// periodic tasks with their shortest inter-arrival time: the time the
+// ADXL345 takes to deliver that many samples, at least one tick.
+#define ACC_SAMPLE_TICKS(samples) \
+    ((samples) * 1000 >= ACC_ODR_HZ * RTK_TICK_MS ? \
+     (samples) * 1000 / (ACC_ODR_HZ * RTK_TICK_MS) : 1)
+
+#if ACC_EVENTS
+#define FILTER_ARRIVAL_TICKS ACC_SAMPLE_TICKS(FILTER_EVENT_SAMPLES)
+#define PLOT_ARRIVAL_TICKS   ACC_SAMPLE_TICKS(PLOT_EVENT_SAMPLES)
+#else
+#define FILTER_ARRIVAL_TICKS ACC_FILTER_PERIOD_TICKS
+#define PLOT_ARRIVAL_TICKS   PLOT_PERIOD_TICKS
+#endif
+
+// Sierra task ids; 0 is the idle task
+#define TASK_ID_ENUM_(id, entry, period, deadline, budget, cs, stack) id,
+enum {
+    TASK_IDLE = 0,
+    TASK_TABLE(TASK_ID_ENUM_)
+    TASK_ID_END
+};
+#define TASK_COUNT (TASK_ID_END - 1)
+
+#define TASK_ENTRY_DECL_(id, entry, period, deadline, budget, cs, stack) void entry(void);
+TASK_TABLE(TASK_ENTRY_DECL_)
+
+// Utilization in per mille, each term rounded up
+#define TASK_UTIL_TERM_(id, entry, period, deadline, budget, cs, stack) \
+    + ((budget) + (period) * RTK_TICK_MS - 1) / ((period) * RTK_TICK_MS)
+#define TASK_UTILIZATION (0 TASK_TABLE(TASK_UTIL_TERM_))
+
+#define TASK_COUNT_TERM_(id, entry, period, deadline, budget, cs, stack) + 1
+#define TASK_TABLE_SIZE (0 TASK_TABLE(TASK_COUNT_TERM_))
+
+// Liu-Layland bound n(2^(1/n) - 1) in per mille, rounded down
+#define RM_BOUND(n) \
+    ((n) <= 1 ? 1000 : (n) == 2 ? 828 : (n) == 3 ? 779 : (n) == 4 ? 756 : \
+     (n) == 5 ? 743 : (n) == 6 ? 734 : (n) == 7 ? 728 : 693)
+
+#if TASK_UTILIZATION > 1000
+#error "Task budgets exceed 100% CPU utilization"
+#endif
+
+typedef struct task_desc {
+    int id;
+    const char *name;
+    void (*entry)(void);
+    alt_u32 period;             // RTK ticks
+    alt_u32 deadline;           // RTK ticks, relative to the release
+    alt_u32 budget_us;          // Worst-case execution time
+    alt_u32 cs_us;              // Longest mutex section
+    char *stack;
+    size_t stack_size;
+    int priority;               // Assigned by tasks_assign_priorities()
+} task_desc_t;
+
+extern task_desc_t task_table[TASK_COUNT];
+
+// Rate-monotonic priorities 1..n (idle keeps 0)
+void tasks_assign_priorities(void);
+
+// Response-time analysis of the table; prints every task that can
+// miss its deadline and returns false if there is one
+bool tasks_schedulable(void);
+
+// Paint the stacks and task_create() the idle task (priority 0) and
+// every table entry with its assigned priority
+void tasks_create(void (*idle)(void));
+
+// Painted bytes never touched at the far end of a stack
+size_t tasks_stack_unused(const char *stack, size_t size);
+
+// Print used/total stack bytes of the idle task and every table entry
+void tasks_stack_report(void);
+
+#endif /* TASKS_H_ */
@@ -0,0 +1,116 @@
+#include <stdbool.h>
+#include <string.h>
+#include "altera_avalon_sierra_ker.h"
+#include "hot.h"
+#include "log.h"
+#include "task_stats.h"
+#include "trace.h"
+
+#if (TRACE_RING_SIZE & TRACE_RING_MASK) != 0
+#error "TRACE_RING_SIZE must be a power of two"
+#endif
+
+trace_record_t trace_ring[TRACE_RING_SIZE] HOT_DATA;
+volatile alt_u32 trace_head HOT_DATA;
+volatile alt_u8 trace_paused;
+
+/* ================================================================
+ *                      TRACED SEMAPHORES
+ * ================================================================ */
+void trace_sem_take(alt_u8 task, int sem)
+{
+    trace_record(TRACE_SEM_TAKE, task, (alt_u16)sem);
+    sem_take(sem);
+    trace_record(TRACE_SEM_ACQUIRED, task, (alt_u16)sem);
+}
+
+void trace_sem_release(alt_u8 task, int sem)
+{
+    trace_record(TRACE_SEM_RELEASE, task, (alt_u16)sem);
+    sem_release(sem);
+}
+
+/* ================================================================
+ *                           DUMP
+ *  Recording is paused while the ring is written out. trace_dump()
+ *  runs from the idle task, so every task that could be half-way
+ *  through a record has already finished it. The bytes are packed
+ *  into CONSOLE_LINE_MAX chunks and written with console_write_all():
+ *  the console is locked per chunk, never while the UART is full.
+ * ================================================================ */
+static struct {
+    alt_u8 bytes[CONSOLE_LINE_MAX];
+    size_t used;
+    bool failed;            // No host reading: the rest is skipped
+} out;
+
+static void flush_out(void)
+{
+    if (!out.failed && out.used > 0)
+        out.failed = !console_write_all(out.bytes, out.used);
+    out.used = 0;
+}
+
+static void put_u8(alt_u8 v)
+{
+    if (out.used == sizeof(out.bytes))
+        flush_out();
+    out.bytes[out.used++] = v;
+}
+
+static void put_u16(alt_u16 v)
+{
+    put_u8(v & 0xFF);
+    put_u8(v >> 8);
+}
+
+static void put_u32(alt_u32 v)
+{
+    put_u16(v & 0xFFFF);
+    put_u16(v >> 16);
+}
+
+void trace_dump(void)
+{
+    alt_u32 head;
+    alt_u32 count;
+    size_t tasks = task_stats_count();
+
+    trace_paused = 1;
+    head = trace_head;
+    count = head < TRACE_RING_SIZE ? head : TRACE_RING_SIZE;
+
+    out.used = 0;
+    out.failed = false;
+
+    put_u8('T');
+    put_u8('R');
+    put_u8('C');
+    put_u8('1');
+    put_u32(alt_timestamp_freq());
+    put_u16(tasks);
+    put_u16(count);
+
+    for (size_t i = 0; i < tasks; i++)
+    {
+        const char *name = task_stats_name(i);
+        size_t len = strlen(name);
+
+        put_u8(len);
+        for (size_t c = 0; c < len; c++)
+            put_u8(name[c]);
+    }
+
+    for (alt_u32 i = head - count; i != head && !out.failed; i++)
+    {
+        const trace_record_t *r = &trace_ring[i & TRACE_RING_MASK];
+
+        put_u32(r->timestamp);
+        put_u8(r->event);
+        put_u8(r->task);
+        put_u16(r->arg);
+    }
+
+    flush_out();
+    trace_paused = 0;
+}
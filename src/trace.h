@@ -0,0 +1,96 @@
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <alt_types.h>
+#include <sys/alt_irq.h>
+#include <sys/alt_timestamp.h>
+#include "app_config.h"
+
+/*
+ * ---------------------------------------------------------------------
+ *  SCHEDULING EVENT TRACE
+ * ---------------------------------------------------------------------
+ *  Power-of-two ring of 8-byte records that always holds the newest
+ *  TRACE_RING_SIZE events. A slot is reserved and timestamped with
+ *  interrupts disabled for a handful of instructions, so tasks and
+ *  ISRs can all record; the record itself is filled in afterwards.
+ *
+ *  The Sierra kernel switches tasks in hardware and gives software no
+ *  hook, so switches are recorded at the points the tasks control:
+ *  waking from a period or a semaphore and going back to sleep. The
+ *  host converter (tools/trace2perfetto.py) rebuilds the timeline
+ *  from those edges.
+ *
+ *  trace_dump() writes the ring to the console (JTAG UART) as:
+ *    "TRC1", u32 timestamp frequency, u16 task count, u16 record
+ *    count, then per task a u8 length and its name, then the records
+ *    oldest first. All fields are little-endian.
+ * ---------------------------------------------------------------------
+ */
+
+typedef enum {
+    TRACE_TASK_WAKE = 1,    // Released for a new period
+    TRACE_TASK_SLEEP,       // Job finished, waiting for the next period
+    TRACE_DEADLINE_MISS,    // Kernel reported an overrun (arg: misses)
+    TRACE_SEM_TAKE,         // About to block on a semaphore (arg: sem)
+    TRACE_SEM_ACQUIRED,     // Semaphore obtained (arg: sem)
+    TRACE_SEM_RELEASE,      // Semaphore released (arg: sem)
+    TRACE_USER              // Free for ad-hoc markers
+} trace_event_t;
+
+typedef struct trace_record {
+    alt_u32 timestamp;      // alt_timestamp() ticks
+    alt_u8 event;           // trace_event_t
+    alt_u8 task;            // task_stats registration index
+    alt_u16 arg;
+} trace_record_t;
+
+// Task field of records made in interrupt context
+#define TRACE_TASK_ISR 0xFF
+
+// Task field of records made by shared code (drivers) that does not
+// know which task called it, or by a task before task_stats_init()
+#define TRACE_TASK_UNKNOWN 0xFE
+
+#define TRACE_RING_MASK (TRACE_RING_SIZE - 1)
+
+extern trace_record_t trace_ring[TRACE_RING_SIZE];
+extern volatile alt_u32 trace_head;     // Total records written
+extern volatile alt_u8 trace_paused;    // Set while trace_dump() runs
+
+static inline void trace_record(trace_event_t event, alt_u8 task, alt_u16 arg)
+{
+#if TRACE_ENABLE
+    alt_irq_context ctx;
+    trace_record_t *r;
+    alt_u32 now;
+
+    if (trace_paused)
+        return;
+
+    ctx = alt_irq_disable_all();
+    now = alt_timestamp();
+    r = &trace_ring[trace_head & TRACE_RING_MASK];
+    trace_head++;
+    alt_irq_enable_all(ctx);
+
+    r->timestamp = now;
+    r->event = event;
+    r->task = task;
+    r->arg = arg;
+#else
+    (void)event;
+    (void)task;
+    (void)arg;
+#endif
+}
+
+// Traced semaphore operations; task is the caller's trace id. Every
+// sem_take()/sem_release() outside bench.c goes through these
+void trace_sem_take(alt_u8 task, int sem);
+void trace_sem_release(alt_u8 task, int sem);
+
+// Write the ring to the console in the binary format above
+void trace_dump(void);
+
+#endif /* TRACE_H_ */
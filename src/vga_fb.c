@@ -0,0 +1,335 @@
+#include <stdio.h>
+#include "io.h"
+#include <DE10_Lite_VGA_Driver.h>
+#include "app_config.h"
+#include "dma.h"
+#include "vga_fb.h"
+
+// Framebuffer fills and copies go through the mSGDMA when both the
+// framebuffer address and the dispatcher are known
+#if defined(VGA_FB_BASE) && defined(VGA_MSGDMA_NAME)
+#define FB_USE_DMA 1
+#else
+#define FB_USE_DMA 0
+#endif
+
+#if VGA_DOUBLE_BUFFER
+
+#ifdef VGA_BACK_BUFFER_SECTION
+#define BACK_BUFFER_ATTR __attribute__((section(VGA_BACK_BUFFER_SECTION), aligned(4)))
+#else
+#define BACK_BUFFER_ATTR __attribute__((aligned(4)))
+#endif
+
+// Off-screen copy of the whole canvas
+static vga_color_t back_buffer[CANVAS_HEIGHT][CANVAS_WIDTH] BACK_BUFFER_ATTR;
+
+// Two pixels of the back buffer read as one word (may alias them)
+typedef alt_u32 __attribute__((may_alias)) pixel_pair_t;
+
+// Changed span of each row since the last present (x0 > x1 means clean)
+static alt_u16 dirty_x0[CANVAS_HEIGHT];
+static alt_u16 dirty_x1[CANVAS_HEIGHT];
+static alt_u16 dirty_y0;
+static alt_u16 dirty_y1;
+
+static void mark_row(size_t x0, size_t x1, size_t y)
+{
+    if (x0 < dirty_x0[y]) dirty_x0[y] = x0;
+    if (x1 > dirty_x1[y]) dirty_x1[y] = x1;
+    if (y < dirty_y0) dirty_y0 = y;
+    if (y > dirty_y1) dirty_y1 = y;
+}
+
+static void clear_dirty(void)
+{
+    for (size_t y = 0; y < CANVAS_HEIGHT; y++)
+    {
+        dirty_x0[y] = CANVAS_WIDTH;
+        dirty_x1[y] = 0;
+    }
+
+#if FB_USE_DMA
+    dma_vga_sync();     // The back buffer is drawn into again next
+#endif
+
+    dirty_y0 = CANVAS_HEIGHT;
+    dirty_y1 = 0;
+}
+
+#endif /* VGA_DOUBLE_BUFFER */
+
+void fb_init(void)
+{
+#if VGA_DOUBLE_BUFFER
+    clear_dirty();
+#endif
+#if FB_USE_DMA
+    if (!dma_vga_open())
+        printf("No VGA DMA: framebuffer writes stay on the CPU\n");
+#endif
+}
+
+/* ================================================================
+ *                      PIXEL WRITE
+ * ================================================================ */
+void fb_pixel(size_t x, size_t y, vga_color_t color)
+{
+    if (x >= CANVAS_WIDTH || y >= CANVAS_HEIGHT)
+        return;
+
+#if VGA_DOUBLE_BUFFER
+    back_buffer[y][x] = color;
+    mark_row(x, x, y);
+#elif defined(VGA_FB_BASE)
+    IOWR_16DIRECT(VGA_FB_BASE, (alt_u32)y * VGA_FB_STRIDE + (x << 1), color);
+#else
+    write_pixel(x, y, color);
+#endif
+}
+
+/* ================================================================
+ *                      SPAN FILL
+ *  With a known framebuffer base the span is written directly:
+ *  an optional leading 16-bit pixel to reach word alignment, then
+ *  two pixels per 32-bit store, then an optional trailing pixel.
+ *  Nothing is checked here: fb_fill_rect(), the only caller, has
+ *  already clipped the span to the canvas and rejected x0 > x1.
+ * ================================================================ */
+static void fill_span(size_t x0, size_t x1, size_t y, vga_color_t color)
+{
+#if VGA_DOUBLE_BUFFER
+    vga_color_t *row = back_buffer[y];
+
+    for (size_t x = x0; x <= x1; x++)
+        row[x] = color;
+
+    mark_row(x0, x1, y);
+#elif defined(VGA_FB_BASE)
+    alt_u32 row = (alt_u32)y * VGA_FB_STRIDE;
+    alt_u32 pair = ((alt_u32)color << 16) | color;
+    size_t x = x0;
+
+    if (x & 1)
+    {
+        IOWR_16DIRECT(VGA_FB_BASE, row + (x << 1), color);
+        x++;
+    }
+
+    for (; x + 1 <= x1; x += 2)
+        IOWR_32DIRECT(VGA_FB_BASE, row + (x << 1), pair);
+
+    if (x == x1)
+        IOWR_16DIRECT(VGA_FB_BASE, row + (x << 1), color);
+#else
+    for (size_t x = x0; x <= x1; x++)
+        write_pixel(x, y, color);
+#endif
+}
+
+/* ================================================================
+ *                      RECTANGLE FILL
+ * ================================================================ */
+#if FB_USE_DMA && !VGA_DOUBLE_BUFFER
+// One row of the fill colour, copied to every row of the rectangle
+static vga_color_t fill_line[CANVAS_WIDTH] __attribute__((aligned(4)));
+static vga_color_t fill_line_color;
+static bool fill_line_valid;
+
+static void dma_fill_rect(size_t x0, size_t y0, size_t x1, size_t y1, vga_color_t color)
+{
+    size_t bytes = (x1 - x0 + 1) * sizeof(vga_color_t);
+
+    if (!fill_line_valid || fill_line_color != color)
+    {
+        for (size_t x = 0; x < CANVAS_WIDTH; x++)
+            fill_line[x] = color;
+
+        fill_line_color = color;
+        fill_line_valid = true;
+    }
+
+    for (size_t y = y0; y <= y1; y++)
+        dma_vga_copy(VGA_FB_BASE + (alt_u32)y * VGA_FB_STRIDE + (x0 << 1), fill_line, bytes);
+
+    dma_vga_sync();
+}
+#endif
+
+void fb_fill_rect(size_t x0, size_t y0, size_t x1, size_t y1, vga_color_t color)
+{
+    if (x1 >= CANVAS_WIDTH)
+        x1 = CANVAS_WIDTH - 1;
+    if (y1 >= CANVAS_HEIGHT)
+        y1 = CANVAS_HEIGHT - 1;
+
+    if (x0 > x1 || y0 > y1)
+        return;
+
+#if FB_USE_DMA && !VGA_DOUBLE_BUFFER
+    // Small fills are cheaper than setting up descriptors
+    if ((x1 - x0 + 1) * (y1 - y0 + 1) >= DMA_MIN_PIXELS)
+    {
+        dma_fill_rect(x0, y0, x1, y1, color);
+        return;
+    }
+#endif
+
+    for (size_t y = y0; y <= y1; y++)
+        fill_span(x0, x1, y, color);
+}
+
+/* ================================================================
+ *                      GLYPH BLIT
+ *  With a known framebuffer base and an even x, each glyph row is
+ *  four 32-bit stores: every pair of bits selects one of four
+ *  pre-combined pixel pairs. The back buffer takes the row as eight
+ *  stores and marks it dirty once.
+ * ================================================================ */
+void fb_glyph(size_t x, size_t y, const alt_u8 rows[8], vga_color_t fg, vga_color_t bg)
+{
+    // Partly off-screen: clip pixel by pixel
+    if (x + 8 > CANVAS_WIDTH || y + 8 > CANVAS_HEIGHT)
+    {
+        for (size_t r = 0; r < 8; r++)
+            for (size_t c = 0; c < 8; c++)
+                fb_pixel(x + c, y + r, (rows[r] >> c) & 1 ? fg : bg);
+        return;
+    }
+
+#if VGA_DOUBLE_BUFFER
+    for (size_t r = 0; r < 8; r++)
+    {
+        vga_color_t *row = &back_buffer[y + r][x];
+        alt_u8 bits = rows[r];
+
+        for (size_t c = 0; c < 8; c++)
+            row[c] = (bits >> c) & 1 ? fg : bg;
+
+        mark_row(x, x + 7, y + r);
+    }
+#elif defined(VGA_FB_BASE)
+    if ((x & 1) == 0)
+    {
+        // Index bit 0 is the left (lower-address) pixel of the pair
+        const alt_u32 pairs[4] = {
+            ((alt_u32)bg << 16) | bg,
+            ((alt_u32)bg << 16) | fg,
+            ((alt_u32)fg << 16) | bg,
+            ((alt_u32)fg << 16) | fg,
+        };
+
+        for (size_t r = 0; r < 8; r++)
+        {
+            alt_u32 addr = (alt_u32)(y + r) * VGA_FB_STRIDE + (x << 1);
+            alt_u8 bits = rows[r];
+
+            IOWR_32DIRECT(VGA_FB_BASE, addr,      pairs[bits & 3]);
+            IOWR_32DIRECT(VGA_FB_BASE, addr + 4,  pairs[(bits >> 2) & 3]);
+            IOWR_32DIRECT(VGA_FB_BASE, addr + 8,  pairs[(bits >> 4) & 3]);
+            IOWR_32DIRECT(VGA_FB_BASE, addr + 12, pairs[bits >> 6]);
+        }
+        return;
+    }
+
+    for (size_t r = 0; r < 8; r++)
+    {
+        alt_u32 addr = (alt_u32)(y + r) * VGA_FB_STRIDE + (x << 1);
+
+        for (size_t c = 0; c < 8; c++)
+            IOWR_16DIRECT(VGA_FB_BASE, addr + (c << 1), (rows[r] >> c) & 1 ? fg : bg);
+    }
+#else
+    for (size_t r = 0; r < 8; r++)
+        for (size_t c = 0; c < 8; c++)
+            write_pixel(x + c, y + r, (rows[r] >> c) & 1 ? fg : bg);
+#endif
+}
+
+/* ================================================================
+ *                      PRESENT
+ *  Waits for vertical blanking (when the pixel buffer DMA controller
+ *  is available) and copies every dirty row span from the back
+ *  buffer to the live framebuffer, one mSGDMA descriptor per span
+ *  when VGA_MSGDMA_NAME is set.
+ * ================================================================ */
+#if VGA_DOUBLE_BUFFER
+
+#ifdef VGA_PIXEL_DMA_BASE
+// Pixel buffer DMA registers (32-bit word offsets)
+#define PIXEL_DMA_BUFFER        0   // Write: swap front/back at next vsync
+#define PIXEL_DMA_BACK_BUFFER   1
+#define PIXEL_DMA_STATUS        3   // Bit 0: swap pending
+
+static void wait_for_vsync(void)
+{
+    // Point the back buffer at the front buffer so the "swap" only
+    // marks the next vertical blanking interval
+    IOWR(VGA_PIXEL_DMA_BASE, PIXEL_DMA_BACK_BUFFER, IORD(VGA_PIXEL_DMA_BASE, PIXEL_DMA_BUFFER));
+    IOWR(VGA_PIXEL_DMA_BASE, PIXEL_DMA_BUFFER, 1);
+
+    while (IORD(VGA_PIXEL_DMA_BASE, PIXEL_DMA_STATUS) & 0x1);
+}
+#endif
+
+static void copy_span(size_t x0, size_t x1, size_t y)
+{
+    const vga_color_t *src = back_buffer[y];
+
+#if FB_USE_DMA
+    dma_vga_copy(VGA_FB_BASE + (alt_u32)y * VGA_FB_STRIDE + (x0 << 1), &src[x0],
+                 (x1 - x0 + 1) * sizeof(vga_color_t));
+#elif defined(VGA_FB_BASE)
+    alt_u32 row = (alt_u32)y * VGA_FB_STRIDE;
+    size_t x = x0;
+
+    if (x & 1)
+    {
+        IOWR_16DIRECT(VGA_FB_BASE, row + (x << 1), src[x]);
+        x++;
+    }
+
+    for (; x + 1 <= x1; x += 2)
+        IOWR_32DIRECT(VGA_FB_BASE, row + (x << 1), *(const pixel_pair_t *)&src[x]);
+
+    if (x == x1)
+        IOWR_16DIRECT(VGA_FB_BASE, row + (x << 1), src[x]);
+#else
+    for (size_t x = x0; x <= x1; x++)
+        write_pixel(x, y, src[x]);
+#endif
+}
+
+void fb_present(void)
+{
+    if (dirty_y0 > dirty_y1)
+        return;
+
+#ifdef VGA_PIXEL_DMA_BASE
+    wait_for_vsync();
+#endif
+
+    for (size_t y = dirty_y0; y <= dirty_y1; y++)
+    {
+        if (dirty_x0[y] <= dirty_x1[y])
+            copy_span(dirty_x0[y], dirty_x1[y], y);
+
+        dirty_x0[y] = CANVAS_WIDTH;
+        dirty_x1[y] = 0;
+    }
+
+#if FB_USE_DMA
+    dma_vga_sync();     // The back buffer is drawn into again next
+#endif
+
+    dirty_y0 = CANVAS_HEIGHT;
+    dirty_y1 = 0;
+}
+
+#else
+
+void fb_present(void)
+{
+}
+
+#endif /* VGA_DOUBLE_BUFFER */
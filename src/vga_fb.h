@@ -0,0 +1,39 @@
+#ifndef VGA_FB_H_
+#define VGA_FB_H_
+
+#include <stddef.h>
+#include <alt_types.h>
+
+/*
+ * ---------------------------------------------------------------------
+ *  LOW-LEVEL FRAMEBUFFER ACCESS
+ * ---------------------------------------------------------------------
+ *  Bulk fills for the DE10-Lite VGA framebuffer. Rectangles are
+ *  inclusive ([x0..x1] x [y0..y1]) like clear_screen_range() and are
+ *  always walked row-major so consecutive writes hit consecutive
+ *  addresses.
+ *
+ *  With VGA_DOUBLE_BUFFER enabled every write lands in an off-screen
+ *  back buffer instead, and fb_present() copies the rows that changed
+ *  since the previous present to the live framebuffer.
+ * ---------------------------------------------------------------------
+ */
+
+typedef alt_u16 vga_color_t;
+
+void fb_init(void);
+
+// Write one pixel
+void fb_pixel(size_t x, size_t y, vga_color_t color);
+
+// Fill an inclusive rectangle, clipped to the canvas
+void fb_fill_rect(size_t x0, size_t y0, size_t x1, size_t y1, vga_color_t color);
+
+// Draw an 8x8 glyph (one byte per row, bit 0 leftmost) in two colours
+void fb_glyph(size_t x, size_t y, const alt_u8 rows[8], vga_color_t fg, vga_color_t bg);
+
+// Copy the changed part of the back buffer to the screen (no-op when
+// double buffering is disabled)
+void fb_present(void);
+
+#endif /* VGA_FB_H_ */
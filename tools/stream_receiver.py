@@ -0,0 +1,133 @@
+#!/usr/bin/env python3
+"""Record the HOST_STREAM sample stream to a CSV file.
+
+Build with -DHOST_STREAM=1, then either pipe the console into the tool
+
+    nios2-terminal | tools/stream_receiver.py -o samples.csv
+
+or convert a raw capture afterwards
+
+    tools/stream_receiver.py capture.bin -o samples.csv
+
+With --serial PORT the stream is read from a UART instead (pyserial).
+Frames are found by their sync word and checked against their CRC, so
+log text on the same port is skipped. Gaps in the sequence number
+(samples the stream dropped) are counted and reported on exit.
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"     # 0x5AA5, little-endian
+FRAME = struct.Struct("<HHIhhhH")
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as host_crc16()."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+class Decoder:
+    """Turns arbitrary chunks of the byte stream into samples."""
+
+    def __init__(self):
+        self.buffer = bytearray()
+        self.frames = 0
+        self.crc_errors = 0
+        self.lost = 0
+        self.last_seq = None
+        self.time_base = 0
+        self.last_stamp = None
+
+    def feed(self, chunk):
+        self.buffer += chunk
+        samples = []
+        pos = 0
+
+        while True:
+            pos = self.buffer.find(SYNC, pos)
+            if pos < 0 or len(self.buffer) - pos < FRAME.size:
+                break
+
+            frame = bytes(self.buffer[pos:pos + FRAME.size])
+            _, seq, stamp, x, y, z, crc = FRAME.unpack(frame)
+            if crc16(frame[2:14]) != crc:
+                # Text that happens to contain the sync bytes, or a
+                # corrupted frame: resynchronise one byte further on
+                self.crc_errors += 1
+                pos += 1
+                continue
+
+            if self.last_seq is not None:
+                self.lost += (seq - self.last_seq - 1) & 0xFFFF
+            self.last_seq = seq
+
+            # Unwrap the 32-bit timestamp
+            if self.last_stamp is not None and stamp < self.last_stamp:
+                self.time_base += 1 << 32
+            self.last_stamp = stamp
+
+            samples.append((seq, self.time_base + stamp, x, y, z))
+            self.frames += 1
+            pos += FRAME.size
+
+        # Keep a possible partial frame (or half a sync word)
+        keep = max(pos if pos >= 0 else len(self.buffer) - 1, 0)
+        del self.buffer[:keep]
+        return samples
+
+
+def open_input(args):
+    if args.serial:
+        import serial   # pyserial, only needed for --serial
+        port = serial.Serial(args.serial, args.baud, timeout=0.1)
+        return lambda: port.read(4096)
+
+    f = sys.stdin.buffer if args.capture == "-" else open(args.capture, "rb")
+    return lambda: f.read1(4096) if hasattr(f, "read1") else f.read(4096)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", nargs="?", default="-",
+                        help="raw capture file (default: stdin)")
+    parser.add_argument("-o", "--output", default="-",
+                        help="output CSV file (default: stdout)")
+    parser.add_argument("--serial", metavar="PORT",
+                        help="read from a serial port instead of a file")
+    parser.add_argument("--baud", type=int, default=115200,
+                        help="serial baud rate (default: 115200)")
+    args = parser.parse_args()
+
+    read = open_input(args)
+    out = sys.stdout if args.output == "-" else open(args.output, "w")
+    decoder = Decoder()
+
+    out.write("seq,timestamp,x,y,z\n")
+    try:
+        while True:
+            chunk = read()
+            if not chunk:
+                if args.serial:
+                    continue
+                break
+            for sample in decoder.feed(chunk):
+                out.write("%d,%d,%d,%d,%d\n" % sample)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        out.flush()
+
+    print("%d frames, %d lost, %d CRC errors"
+          % (decoder.frames, decoder.lost, decoder.crc_errors), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,162 @@
+#!/usr/bin/env python3
+"""Convert a trace_dump() capture into a Chrome trace / Perfetto timeline.
+
+Capture the JTAG UART output to a file while pressing KEY1, e.g.
+
+    nios2-terminal > capture.bin
+
+then run
+
+    tools/trace2perfetto.py capture.bin -o trace.json
+
+and open trace.json in https://ui.perfetto.dev or chrome://tracing.
+Any console text before or after the binary block is ignored; when the
+capture holds several dumps the last one is converted (or pick one with
+--dump N).
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+MAGIC = b"TRC1"
+
+TASK_WAKE = 1
+TASK_SLEEP = 2
+DEADLINE_MISS = 3
+SEM_TAKE = 4
+SEM_ACQUIRED = 5
+SEM_RELEASE = 6
+USER = 7
+
+TASK_ISR = 0xFF
+TASK_UNKNOWN = 0xFE
+
+INSTANT_NAMES = {
+    DEADLINE_MISS: "deadline miss",
+    SEM_RELEASE: "sem_release",
+    USER: "marker",
+}
+
+
+def parse_dump(data, offset):
+    """Parse one dump starting at the magic.
+
+    Returns (freq, tasks, records, end offset)."""
+    pos = offset + len(MAGIC)
+    freq, task_count, record_count = struct.unpack_from("<IHH", data, pos)
+    pos += 8
+
+    tasks = []
+    for _ in range(task_count):
+        length = data[pos]
+        pos += 1
+        tasks.append(data[pos:pos + length].decode("ascii", "replace"))
+        pos += length
+
+    records = []
+    for _ in range(record_count):
+        records.append(struct.unpack_from("<IBBH", data, pos))
+        pos += 8
+
+    return freq, tasks, records, pos
+
+
+def find_dumps(data):
+    """Return every complete dump; the search resumes after each one so
+    record bytes that happen to spell the magic are not mistaken for a
+    new dump."""
+    dumps = []
+    pos = data.find(MAGIC)
+    while pos >= 0:
+        try:
+            dump = parse_dump(data, pos)
+        except (struct.error, IndexError):
+            break   # Truncated capture
+        dumps.append(dump[:3])
+        pos = data.find(MAGIC, dump[3])
+    return dumps
+
+
+def to_events(freq, tasks, records):
+    """Build Chrome trace events; timestamps are unwrapped from 32 bits."""
+    events = [{"name": "process_name", "ph": "M", "pid": 0,
+               "args": {"name": "Sierra RTK"}}]
+
+    for tid, name in enumerate(tasks):
+        events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": tid,
+                       "args": {"name": name}})
+    events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": TASK_ISR,
+                   "args": {"name": "ISR"}})
+    events.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": TASK_UNKNOWN,
+                   "args": {"name": "unknown task"}})
+
+    base = None
+    last = 0
+    wraps = 0
+    running = set()
+
+    for stamp, event, task, arg in records:
+        if base is None:
+            base = stamp
+        elif stamp < last:
+            wraps += 1
+        last = stamp
+
+        ticks = (wraps << 32) + stamp - base
+        ts = ticks * 1e6 / freq
+        common = {"pid": 0, "tid": task, "ts": ts}
+
+        if event == TASK_WAKE:
+            events.append(dict(common, name="job", ph="B"))
+            running.add(task)
+        elif event == TASK_SLEEP:
+            # A job that started before the oldest record has no begin
+            if task in running:
+                events.append(dict(common, name="job", ph="E"))
+                running.discard(task)
+        elif event == SEM_TAKE:
+            events.append(dict(common, name="sem %d" % arg, ph="B",
+                               args={"sem": arg}))
+        elif event == SEM_ACQUIRED:
+            events.append(dict(common, name="sem %d" % arg, ph="E"))
+        elif event in INSTANT_NAMES:
+            events.append(dict(common, name=INSTANT_NAMES[event], ph="i",
+                               s="t", args={"arg": arg}))
+
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("capture", help="raw JTAG UART capture")
+    parser.add_argument("-o", "--output", default="-",
+                        help="output JSON file (default: stdout)")
+    parser.add_argument("--dump", type=int, default=-1,
+                        help="index of the dump to convert (default: last)")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        data = f.read()
+
+    dumps = find_dumps(data)
+    if not dumps:
+        sys.exit("no trace dump found in %s" % args.capture)
+
+    freq, tasks, records = dumps[args.dump]
+    trace = {"traceEvents": to_events(freq, tasks, records),
+             "displayTimeUnit": "ms"}
+
+    if args.output == "-":
+        json.dump(trace, sys.stdout)
+    else:
+        with open(args.output, "w") as f:
+            json.dump(trace, f)
+
+    print("%d records from %d tasks" % (len(records), len(tasks)),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()